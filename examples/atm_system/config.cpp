@@ -14,7 +14,9 @@ class CfgPatches
         requiredAddons[] = {
             "DZ_Data",            // Vanilla DayZ data
             "DZ_Characters",      // Player characters
-            "DZ_Items_Weapons"    // Weapon items (for card model)
+            "DZ_Items_Weapons",   // Weapon items (for card model)
+            "PlayerRegistry",     // Online player lookup (examples/player_registry)
+            "ModLogger"           // Leveled logging (examples/mod_logger)
         };
     };
 };
@@ -2,7 +2,7 @@
 // BANKING ACCOUNT DATA STRUCTURE
 // ============================================================
 // This class represents a player's bank account
-// Persists to JSON file in $profile:Banking/
+// Persists through BankingAccountStore (see BankingAccountStore.c)
 
 class BankingAccount
 {
@@ -12,7 +12,18 @@ class BankingAccount
     int MaxBalance;             // Maximum allowed balance
     int DailyWithdrawn;         // Amount withdrawn today (for daily limit)
     int LastWithdrawReset;      // Last time daily withdrawal was reset (Unix timestamp)
-    ref array<ref BankingTransaction> TransactionHistory;  // Transaction log
+    ref array<ref BankingTransaction> TransactionHistory;  // Transaction log (ring buffer)
+    int HistoryStart;           // Index of oldest entry once the ring buffer is full
+    int HistoryTotal;           // Transactions ever added (used by delta sync)
+    int JournalSeq;             // Last journal record included in this snapshot
+    int LastCreditSeq;          // Last pending credit folded into Balance
+    int LastBulkOperation;      // Last bulk operation applied (BankingBulkOperation)
+
+    [NonSerialized()]
+    protected bool m_IsDirty;   // Changed in memory, not yet written to disk
+
+    [NonSerialized()]
+    protected bool m_IsNew;     // Created by Load (no snapshot existed)
 
     // ============================================================
     // CONSTRUCTOR - Initialize new account
@@ -23,7 +34,33 @@ class BankingAccount
         MaxBalance = GetBankingConfig().DefaultMaxBalance;
         DailyWithdrawn = 0;
         LastWithdrawReset = 0;
+        JournalSeq = 0;
+        LastCreditSeq = 0;
+        LastBulkOperation = 0;
+        HistoryStart = 0;
+        HistoryTotal = 0;
         TransactionHistory = new array<ref BankingTransaction>;
+        m_IsDirty = false;
+        m_IsNew = false;
+    }
+
+    // ============================================================
+    // DIRTY STATE - Tracks unsaved changes for write-behind mode
+    // ============================================================
+    void MarkDirty()
+    {
+        m_IsDirty = true;
+    }
+
+    bool IsDirty()
+    {
+        return m_IsDirty;
+    }
+
+    // True for an account that did not exist before this load
+    bool IsNew()
+    {
+        return m_IsNew;
     }
 
     // ============================================================
@@ -56,9 +93,9 @@ class BankingAccount
 
         Balance += amount;
 
-        if (GetBankingConfig().BankingLogs)
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.INFO))
         {
-            Print("[ATM System] Deposit: " + PlayerName + " deposited " + amount.ToString() + " (New Balance: " + Balance.ToString() + ")");
+            ModLogger.Info(BANKING_LOG, "Deposit: " + PlayerName + " deposited " + amount.ToString() + " (New Balance: " + Balance.ToString() + ")");
         }
 
         return true;
@@ -106,9 +143,9 @@ class BankingAccount
         Balance -= amount;
         DailyWithdrawn += amount;
 
-        if (GetBankingConfig().BankingLogs)
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.INFO))
         {
-            Print("[ATM System] Withdraw: " + PlayerName + " withdrew " + amount.ToString() + " (New Balance: " + Balance.ToString() + ")");
+            ModLogger.Info(BANKING_LOG, "Withdraw: " + PlayerName + " withdrew " + amount.ToString() + " (New Balance: " + Balance.ToString() + ")");
         }
 
         return true;
@@ -152,9 +189,9 @@ class BankingAccount
         int totalDeduction = amount + fee;
         Balance -= totalDeduction;
 
-        if (GetBankingConfig().BankingLogs)
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.INFO))
         {
-            Print("[ATM System] Transfer: " + PlayerName + " transferred " + amount.ToString() + " (Fee: " + fee.ToString() + ") (New Balance: " + Balance.ToString() + ")");
+            ModLogger.Info(BANKING_LOG, "Transfer: " + PlayerName + " transferred " + amount.ToString() + " (Fee: " + fee.ToString() + ") (New Balance: " + Balance.ToString() + ")");
         }
 
         return true;
@@ -192,126 +229,256 @@ class BankingAccount
     // ============================================================
     // ADD TRANSACTION TO HISTORY
     // ============================================================
+    // Fixed-capacity ring buffer: once full, the oldest entry is
+    // overwritten in place (no array shifting)
     void AddTransactionToHistory(BankingTransaction transaction)
     {
-        TransactionHistory.Insert(transaction);
+        int capacity = GetBankingConfig().TransactionHistorySize;
+        HistoryTotal++;
+
+        // Capacity changed on config reload - rebuild the ring first
+        if (TransactionHistory.Count() > capacity || (HistoryStart != 0 && TransactionHistory.Count() < capacity))
+        {
+            NormalizeHistory();
+        }
 
-        // Limit history to last 100 transactions (prevent file bloat)
-        if (TransactionHistory.Count() > 100)
+        if (TransactionHistory.Count() < capacity)
         {
-            TransactionHistory.Remove(0);  // Remove oldest
+            TransactionHistory.Insert(transaction);
+            return;
         }
+
+        TransactionHistory[HistoryStart] = transaction;
+        HistoryStart = (HistoryStart + 1) % capacity;
     }
 
     // ============================================================
-    // SAVE ACCOUNT TO JSON FILE
+    // GET HISTORY COUNT - Number of stored transactions
     // ============================================================
-    void Save()
+    int GetHistoryCount()
     {
-        string bankingDir = "$profile:Banking/";
+        return TransactionHistory.Count();
+    }
 
-        // Create directory if it doesn't exist
-        if (!FileExist(bankingDir))
+    // ============================================================
+    // GET HISTORY ENTRY - 0 = newest, Count-1 = oldest
+    // ============================================================
+    BankingTransaction GetHistoryEntry(int index)
+    {
+        int count = TransactionHistory.Count();
+        if (index < 0 || index >= count)
         {
-            MakeDirectory(bankingDir);
+            return null;
         }
 
-        // Create backup if enabled
-        if (GetBankingConfig().AutoBackup)
+        // Newest entry sits just before HistoryStart
+        int slot = (HistoryStart + count - 1 - index) % count;
+        return TransactionHistory[slot];
+    }
+
+    // ============================================================
+    // GET HISTORY PAGE - Newest first, page 0 = most recent
+    // ============================================================
+    void GetHistoryPage(int page, int pageSize, array<ref BankingTransaction> result)
+    {
+        int count = TransactionHistory.Count();
+        int first = page * pageSize;
+        if (first < 0 || first >= count)
         {
-            CreateBackup();
+            return;  // Past the end (or overflowed)
         }
 
-        // Save account to JSON file
-        string filePath = bankingDir + SteamID64 + ".json";
-        JsonFileLoader<BankingAccount>.JsonSaveFile(filePath, this);
+        int last = Math.Min(first + pageSize, count);
 
-        if (GetBankingConfig().BankingLogs)
+        for (int i = first; i < last; i++)
         {
-            Print("[ATM System] Account saved: " + PlayerName + " (" + SteamID64 + ")");
+            result.Insert(GetHistoryEntry(i));
         }
     }
 
     // ============================================================
-    // CREATE BACKUP OF ACCOUNT FILE
+    // NORMALIZE HISTORY - Fit loaded history to configured capacity
     // ============================================================
-    void CreateBackup()
+    // Re-linearizes the ring (oldest first) and drops the oldest entries
+    // if TransactionHistorySize was lowered since the file was written
+    void NormalizeHistory()
     {
-        string bankingDir = "$profile:Banking/";
-        string backupDir = bankingDir + "Backups/";
+        int capacity = GetBankingConfig().TransactionHistorySize;
+        int count = TransactionHistory.Count();
 
-        // Create backup directory if it doesn't exist
-        if (!FileExist(backupDir))
+        if (HistoryStart == 0 && count <= capacity)
         {
-            MakeDirectory(backupDir);
+            return;
         }
 
-        // Backup filename with timestamp
-        int currentTime = GetGame().GetTickTime();
-        string backupFile = backupDir + SteamID64 + "_" + currentTime.ToString() + ".json";
+        array<ref BankingTransaction> ordered = new array<ref BankingTransaction>;
+        int keep = Math.Min(count, capacity);
 
-        // Copy current file to backup
-        string currentFile = bankingDir + SteamID64 + ".json";
-        if (FileExist(currentFile))
+        for (int i = keep - 1; i >= 0; i--)
         {
-            BankingAccount temp = new BankingAccount();
-            JsonFileLoader<BankingAccount>.JsonLoadFile(currentFile, temp);
-            JsonFileLoader<BankingAccount>.JsonSaveFile(backupFile, temp);
-
-            // Clean old backups
-            CleanOldBackups();
+            ordered.Insert(GetHistoryEntry(i));
         }
+
+        TransactionHistory = ordered;
+        HistoryStart = 0;
     }
 
     // ============================================================
-    // CLEAN OLD BACKUPS - Remove backups older than retention period
+    // BINARY SERIALIZATION - Used by BankingBinaryAccountStore
     // ============================================================
-    void CleanOldBackups()
+    // History is written oldest first as one BankingTransactionCodec
+    // batch, so the ring is linear on load
+    void WriteBinary(Serializer ctx)
     {
-        string backupDir = "$profile:Banking/Backups/";
-        int retentionDays = GetBankingConfig().BackupRetentionDays;
-        int cutoffTime = GetGame().GetTickTime() - (retentionDays * 86400);
+        ctx.Write(SteamID64);
+        ctx.Write(PlayerName);
+        ctx.Write(Balance);
+        ctx.Write(MaxBalance);
+        ctx.Write(DailyWithdrawn);
+        ctx.Write(LastWithdrawReset);
+        ctx.Write(HistoryTotal);
+        ctx.Write(JournalSeq);
+        ctx.Write(LastCreditSeq);
+        ctx.Write(LastBulkOperation);
+
+        array<ref BankingTransaction> ordered = new array<ref BankingTransaction>;
+        for (int i = TransactionHistory.Count() - 1; i >= 0; i--)
+        {
+            ordered.Insert(GetHistoryEntry(i));
+        }
 
-        // Find all backup files for this player
-        array<string> files = {};
-        FindFiles(backupDir, files, "*" + SteamID64 + "_*.json");
+        BankingTransactionCodec.Encode(ordered).Write(ctx);
+    }
 
-        foreach (string file : files)
+    bool ReadBinary(Serializer ctx, int version)
+    {
+        if (!ctx.Read(SteamID64)) return false;
+        if (!ctx.Read(PlayerName)) return false;
+        if (!ctx.Read(Balance)) return false;
+        if (!ctx.Read(MaxBalance)) return false;
+        if (!ctx.Read(DailyWithdrawn)) return false;
+        if (!ctx.Read(LastWithdrawReset)) return false;
+        if (!ctx.Read(HistoryTotal)) return false;
+        if (!ctx.Read(JournalSeq)) return false;
+        if (!ctx.Read(LastCreditSeq)) return false;
+
+        if (version >= 3)
         {
-            // Extract timestamp from filename
-            int timestampStart = file.IndexOf("_") + 1;
-            int timestampEnd = file.IndexOf(".json");
-            string timestampStr = file.Substring(timestampStart, timestampEnd - timestampStart);
-            int timestamp = timestampStr.ToInt();
+            if (!ctx.Read(LastBulkOperation)) return false;
+        }
 
-            // Delete if older than retention period
-            if (timestamp < cutoffTime)
+        TransactionHistory = new array<ref BankingTransaction>;
+        HistoryStart = 0;
+
+        if (version >= 2)
+        {
+            BankingTransactionBatch batch = new BankingTransactionBatch();
+            if (!batch.Read(ctx) || !BankingTransactionCodec.Decode(batch, TransactionHistory))
             {
-                DeleteFile(file);
+                return false;
             }
         }
+        else
+        {
+            // Version 1: string fields per transaction
+            int count;
+            if (!ctx.Read(count)) return false;
+
+            for (int i = 0; i < count; i++)
+            {
+                BankingLegacyTransaction legacy = new BankingLegacyTransaction();
+                if (!legacy.ReadBinary(ctx))
+                {
+                    return false;
+                }
+
+                TransactionHistory.Insert(legacy.ToTransaction());
+            }
+        }
+
+        NormalizeHistory();
+        return true;
     }
 
     // ============================================================
-    // LOAD ACCOUNT FROM JSON FILE (Static Factory Method)
+    // CONVERT LEGACY HISTORY - Old JSON files with string fields
     // ============================================================
-    static ref BankingAccount Load(string playerID, string playerName = "")
+    // Entries from pre-codec JSON load without a type; if any are
+    // found the history is re-read with the legacy layout.
+    void ConvertLegacyHistory(string filePath)
     {
-        string filePath = "$profile:Banking/" + playerID + ".json";
+        bool legacy = false;
+        foreach (BankingTransaction transaction : TransactionHistory)
+        {
+            if (transaction.Type == BankingTransactionType.UNKNOWN)
+            {
+                legacy = true;
+                break;
+            }
+        }
+
+        if (!legacy)
+        {
+            return;
+        }
 
-        BankingAccount account;
+        BankingLegacyAccountHistory history = new BankingLegacyAccountHistory();
+        JsonFileLoader<BankingLegacyAccountHistory>.JsonLoadFile(filePath, history);
+        if (!history.TransactionHistory || history.TransactionHistory.Count() != TransactionHistory.Count())
+        {
+            return;
+        }
 
-        // Check if account file exists
-        if (FileExist(filePath))
+        for (int i = 0; i < TransactionHistory.Count(); i++)
         {
-            // Load existing account
-            account = new BankingAccount();
-            JsonFileLoader<BankingAccount>.JsonLoadFile(filePath, account);
+            TransactionHistory[i] = history.TransactionHistory[i].ToTransaction();
+        }
+    }
+
+    // ============================================================
+    // SAVE ACCOUNT - Write snapshot through the account store
+    // ============================================================
+    void Save()
+    {
+        if (!BankingAccountStore.GetInstance().Save(this))
+        {
+            ModLogger.Error(BANKING_LOG, "Failed to save account: " + PlayerName + " (" + SteamID64 + ")");
+            return;
+        }
+
+        BankingIOStats.AccountWrites++;
+
+        m_IsDirty = false;
+
+        // Periodic backup (at most once per BackupIntervalMinutes)
+        BankingBackupManager.GetInstance().OnAccountSaved(this);
 
-            if (GetBankingConfig().BankingLogs)
+#ifdef DEVELOPER
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug(BANKING_LOG, "Account saved: " + PlayerName + " (" + SteamID64 + ")");
+        }
+#endif
+    }
+
+    // ============================================================
+    // LOAD ACCOUNT FROM STORE (Static Factory Method)
+    // ============================================================
+    static ref BankingAccount Load(string playerID, string playerName = "")
+    {
+        BankingAccount account = new BankingAccount();
+
+        // Load existing account (migrates legacy JSON files)
+        if (BankingAccountStore.GetInstance().Load(playerID, account))
+        {
+            BankingIOStats.AccountReads++;
+
+#ifdef DEVELOPER
+            if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.DEBUG))
             {
-                Print("[ATM System] Account loaded: " + account.PlayerName + " (" + playerID + ")");
+                ModLogger.Debug(BANKING_LOG, "Account loaded: " + account.PlayerName + " (" + playerID + ")");
             }
+#endif
         }
         else
         {
@@ -321,34 +488,47 @@ class BankingAccount
             account.PlayerName = playerName;
             account.Balance = GetBankingConfig().DefaultStartBalance;
             account.MaxBalance = GetBankingConfig().DefaultMaxBalance;
+            account.m_IsNew = true;
             account.Save();
 
-            if (GetBankingConfig().BankingLogs)
+            if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.INFO))
             {
-                Print("[ATM System] New account created: " + playerName + " (" + playerID + ") with starting balance: " + account.Balance.ToString());
+                ModLogger.Info(BANKING_LOG, "New account created: " + playerName + " (" + playerID + ") with starting balance: " + account.Balance.ToString());
             }
         }
 
         return account;
     }
+}
 
-    // ============================================================
-    // HELPER - Find all files in directory
-    // ============================================================
-    void FindFiles(string path, array<string> files, string pattern)
+// ============================================================
+// BANKING ACCOUNT SUMMARY - Client-side view of an account
+// ============================================================
+// Everything the ATM menu needs except the transaction history,
+// which is requested page by page (RequestHistory RPC).
+// Kept up to date by BankingClientAccountCache from sync deltas.
+class BankingAccountSummary
+{
+    int Revision;                   // Sync revision (see BankingSync.c)
+    string SteamID64;
+    string PlayerName;
+    int Balance;
+    int MaxBalance;
+    int RemainingDailyWithdrawal;   // -1 = unlimited
+    int HistoryCount;
+
+    void BankingAccountSummary(BankingAccount account = null)
     {
-        // Note: DayZ EnScript doesn't have built-in directory traversal
-        // This is a placeholder for the logic
-        // In production, you'd use a different approach or external tools
-    }
+        if (!account)
+        {
+            return;
+        }
 
-    // ============================================================
-    // HELPER - Delete file
-    // ============================================================
-    void DeleteFile(string filePath)
-    {
-        // Note: DayZ EnScript doesn't have built-in file deletion
-        // This is a placeholder
-        // In production, you'd use a different approach
+        SteamID64 = account.SteamID64;
+        PlayerName = account.PlayerName;
+        Balance = account.Balance;
+        MaxBalance = account.MaxBalance;
+        RemainingDailyWithdrawal = account.GetRemainingDailyWithdrawal();
+        HistoryCount = account.GetHistoryCount();
     }
 }
@@ -0,0 +1,291 @@
+// ============================================================
+// BANKING ACCOUNT CACHE - Capacity-bounded LRU cache
+// ============================================================
+// Keeps recently used accounts in memory.
+// - Get() moves an account to the front (most recently used)
+// - Overflow is evicted from the back (least recently used)
+// - Pinned accounts (online players) are never evicted
+//
+// Entries form a doubly linked list owned by the map.
+// List links are weak (no ref) so the map alone controls lifetime.
+
+class BankingCacheEntry
+{
+    string PlayerID;
+    ref BankingAccount Account;
+    BankingCacheEntry Prev;     // Towards most recently used
+    BankingCacheEntry Next;     // Towards least recently used
+
+    void BankingCacheEntry(string playerID, BankingAccount account)
+    {
+        PlayerID = playerID;
+        Account = account;
+    }
+}
+
+class BankingAccountCache
+{
+    protected ref map<string, ref BankingCacheEntry> m_Entries;
+    protected ref set<string> m_Pinned;
+    protected BankingCacheEntry m_Head;     // Most recently used
+    protected BankingCacheEntry m_Tail;     // Least recently used
+    protected int m_Capacity;
+
+    // Statistics
+    protected int m_Hits;
+    protected int m_Misses;
+    protected int m_Evictions;
+
+    // ============================================================
+    // CONSTRUCTOR
+    // ============================================================
+    void BankingAccountCache(int capacity)
+    {
+        m_Entries = new map<string, ref BankingCacheEntry>;
+        m_Pinned = new set<string>;
+        m_Capacity = capacity;
+        m_Hits = 0;
+        m_Misses = 0;
+        m_Evictions = 0;
+    }
+
+    // ============================================================
+    // GET - Lookup that counts hit/miss and refreshes recency
+    // ============================================================
+    BankingAccount Get(string playerID)
+    {
+        BankingCacheEntry entry = m_Entries.Get(playerID);
+        if (!entry)
+        {
+            m_Misses++;
+            return null;
+        }
+
+        m_Hits++;
+        MoveToFront(entry);
+        return entry.Account;
+    }
+
+    // ============================================================
+    // PEEK - Lookup without touching statistics or recency
+    // ============================================================
+    BankingAccount Peek(string playerID)
+    {
+        BankingCacheEntry entry = m_Entries.Get(playerID);
+        if (!entry)
+        {
+            return null;
+        }
+
+        return entry.Account;
+    }
+
+    // ============================================================
+    // PUT - Insert or replace account as most recently used
+    // ============================================================
+    void Put(string playerID, BankingAccount account)
+    {
+        BankingCacheEntry entry = m_Entries.Get(playerID);
+        if (entry)
+        {
+            entry.Account = account;
+            MoveToFront(entry);
+            return;
+        }
+
+        entry = new BankingCacheEntry(playerID, account);
+        m_Entries.Set(playerID, entry);
+        LinkFront(entry);
+    }
+
+    // ============================================================
+    // REMOVE - Drop one account
+    // ============================================================
+    void Remove(string playerID)
+    {
+        BankingCacheEntry entry = m_Entries.Get(playerID);
+        if (!entry)
+        {
+            return;
+        }
+
+        Unlink(entry);
+        m_Entries.Remove(playerID);
+    }
+
+    // ============================================================
+    // PIN / UNPIN - Pinned accounts survive eviction
+    // ============================================================
+    // Pins are kept by ID, so an account can be pinned before it is loaded
+    void Pin(string playerID)
+    {
+        m_Pinned.Insert(playerID);
+    }
+
+    void Unpin(string playerID)
+    {
+        int index = m_Pinned.Find(playerID);
+        if (index >= 0)
+        {
+            m_Pinned.Remove(index);
+        }
+    }
+
+    bool IsPinned(string playerID)
+    {
+        return m_Pinned.Find(playerID) >= 0;
+    }
+
+    // ============================================================
+    // EVICT OVERFLOW - Remove LRU unpinned accounts above capacity
+    // ============================================================
+    // Evicted accounts are returned so the caller can flush them
+    void EvictOverflow(array<ref BankingAccount> evicted)
+    {
+        BankingCacheEntry entry = m_Tail;
+
+        while (entry && m_Entries.Count() > m_Capacity)
+        {
+            BankingCacheEntry prev = entry.Prev;
+
+            if (!IsPinned(entry.PlayerID))
+            {
+                evicted.Insert(entry.Account);
+                Unlink(entry);
+                m_Entries.Remove(entry.PlayerID);
+                m_Evictions++;
+            }
+
+            entry = prev;
+        }
+    }
+
+    // ============================================================
+    // GET ACCOUNTS - Snapshot of all cached accounts
+    // ============================================================
+    void GetAccounts(array<BankingAccount> accounts)
+    {
+        foreach (string playerID, BankingCacheEntry entry : m_Entries)
+        {
+            accounts.Insert(entry.Account);
+        }
+    }
+
+    // ============================================================
+    // CLEAR - Drop everything (pins are kept)
+    // ============================================================
+    void Clear()
+    {
+        m_Head = null;
+        m_Tail = null;
+        m_Entries.Clear();
+    }
+
+    // ============================================================
+    // STATISTICS
+    // ============================================================
+    int Count()
+    {
+        return m_Entries.Count();
+    }
+
+    int GetCapacity()
+    {
+        return m_Capacity;
+    }
+
+    void SetCapacity(int capacity)
+    {
+        m_Capacity = capacity;
+    }
+
+    int GetHits()
+    {
+        return m_Hits;
+    }
+
+    int GetMisses()
+    {
+        return m_Misses;
+    }
+
+    int GetEvictions()
+    {
+        return m_Evictions;
+    }
+
+    float GetHitRate()
+    {
+        int total = m_Hits + m_Misses;
+        if (total == 0)
+        {
+            return 0;
+        }
+
+        float hits = m_Hits;
+        return hits / total;
+    }
+
+    void ResetStats()
+    {
+        m_Hits = 0;
+        m_Misses = 0;
+        m_Evictions = 0;
+    }
+
+    // ============================================================
+    // LIST HELPERS
+    // ============================================================
+    protected void LinkFront(BankingCacheEntry entry)
+    {
+        entry.Prev = null;
+        entry.Next = m_Head;
+
+        if (m_Head)
+        {
+            m_Head.Prev = entry;
+        }
+
+        m_Head = entry;
+
+        if (!m_Tail)
+        {
+            m_Tail = entry;
+        }
+    }
+
+    protected void Unlink(BankingCacheEntry entry)
+    {
+        if (entry.Prev)
+        {
+            entry.Prev.Next = entry.Next;
+        }
+        else
+        {
+            m_Head = entry.Next;
+        }
+
+        if (entry.Next)
+        {
+            entry.Next.Prev = entry.Prev;
+        }
+        else
+        {
+            m_Tail = entry.Prev;
+        }
+
+        entry.Prev = null;
+        entry.Next = null;
+    }
+
+    protected void MoveToFront(BankingCacheEntry entry)
+    {
+        if (entry == m_Head)
+        {
+            return;
+        }
+
+        Unlink(entry);
+        LinkFront(entry);
+    }
+}
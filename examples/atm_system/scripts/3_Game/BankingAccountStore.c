@@ -0,0 +1,511 @@
+// ============================================================
+// BANKING ACCOUNT STORE - Where account snapshots live on disk
+// ============================================================
+// BankingAccount.Save/Load go through the store selected by
+// BankingConfig.AccountStorage:
+//   "binary" - BankingBinaryAccountStore (default)
+//   "json"   - BankingJsonAccountStore (legacy flat directory)
+//
+// Other storage backends can extend BankingAccountStore and be
+// returned from CreateStore.
+
+class BankingAccountStore
+{
+    static const string BANKING_DIR = "$profile:Banking/";
+
+    private static ref BankingAccountStore m_Instance;
+
+    // ============================================================
+    // GET INSTANCE - Store selected in config
+    // ============================================================
+    static BankingAccountStore GetInstance()
+    {
+        if (!m_Instance)
+        {
+            m_Instance = CreateStore(GetBankingConfig().AccountStorage);
+            ModLogger.Info(BANKING_LOG, "Account storage: " + m_Instance.GetName());
+        }
+
+        return m_Instance;
+    }
+
+    static BankingAccountStore CreateStore(string storage)
+    {
+        if (storage == "json")
+        {
+            return new BankingJsonAccountStore();
+        }
+
+        return new BankingBinaryAccountStore(GetBankingConfig().AccountStoreShards);
+    }
+
+    // ============================================================
+    // STORE INTERFACE
+    // ============================================================
+    string GetName()
+    {
+        return "none";
+    }
+
+    // Account snapshot exists
+    bool Exists(string playerID)
+    {
+        return false;
+    }
+
+    // Fills account; false if missing or unreadable
+    bool Load(string playerID, BankingAccount account)
+    {
+        return false;
+    }
+
+    // Like Load, but never writes (no migration) - for scans
+    bool Read(string playerID, BankingAccount account)
+    {
+        return Load(playerID, account);
+    }
+
+    bool Save(BankingAccount account)
+    {
+        return false;
+    }
+
+    // Appends the IDs of all stored accounts (for full scans)
+    void ListAccounts(array<string> result)
+    {
+        for (int chunk = 0; chunk < GetListChunkCount(); chunk++)
+        {
+            ListChunk(chunk, result);
+        }
+    }
+
+    // ListAccounts in parts, so scans can spread it over several ticks
+    // (BankingAccountListing)
+    int GetListChunkCount()
+    {
+        return 1;
+    }
+
+    void ListChunk(int chunk, array<string> result)
+    {
+        ListLegacyAccounts(result);
+    }
+
+    // ============================================================
+    // HASH SHARD - Stable shard number of an account
+    // ============================================================
+    static int HashShard(string playerID, int shardCount)
+    {
+        return (playerID.Hash() & 0x7FFFFFFF) % Math.Max(shardCount, 1);
+    }
+
+    // ============================================================
+    // LEGACY JSON FILE - $profile:Banking/<SteamID64>.json
+    // ============================================================
+    static string GetLegacyFile(string playerID)
+    {
+        return BANKING_DIR + playerID + ".json";
+    }
+
+    // IDs of legacy JSON accounts; other JSON files in the directory
+    // (journal and ledger state) are skipped as they are not numeric
+    static void ListLegacyAccounts(array<string> result)
+    {
+        ListFiles(BANKING_DIR, ".json", result);
+
+        for (int i = result.Count() - 1; i >= 0; i--)
+        {
+            if (!IsSteamID(result[i]))
+            {
+                result.RemoveOrdered(i);
+            }
+        }
+    }
+
+    // Appends names (without extension) of files in dir ending in extension
+    static void ListFiles(string dir, string extension, array<string> result)
+    {
+        string fileName;
+        FileAttr attributes;
+        FindFileHandle handle = FindFile(dir + "*" + extension, fileName, attributes, 0);
+        if (!handle)
+        {
+            return;
+        }
+
+        int extLength = extension.Length();
+        bool found = true;
+        while (found)
+        {
+            int nameLength = fileName.Length() - extLength;
+            if (!(attributes & FileAttr.DIRECTORY) && nameLength > 0 && fileName.Substring(nameLength, extLength) == extension)
+            {
+                result.Insert(fileName.Substring(0, nameLength));
+            }
+
+            found = FindNextFile(handle, fileName, attributes);
+        }
+
+        CloseFindFile(handle);
+    }
+
+    static bool IsSteamID(string value)
+    {
+        if (value == "")
+        {
+            return false;
+        }
+
+        for (int i = 0; i < value.Length(); i++)
+        {
+            if ("0123456789".IndexOf(value.Get(i)) < 0)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+// ============================================================
+// JSON STORE - One JSON file per account in $profile:Banking/
+// ============================================================
+class BankingJsonAccountStore : BankingAccountStore
+{
+    override string GetName()
+    {
+        return "json";
+    }
+
+    override bool Exists(string playerID)
+    {
+        return FileExist(GetLegacyFile(playerID));
+    }
+
+    override bool Load(string playerID, BankingAccount account)
+    {
+        string filePath = GetLegacyFile(playerID);
+        if (!FileExist(filePath))
+        {
+            return false;
+        }
+
+        JsonFileLoader<BankingAccount>.JsonLoadFile(filePath, account);
+        account.ConvertLegacyHistory(filePath);
+        account.NormalizeHistory();
+        return true;
+    }
+
+    override bool Save(BankingAccount account)
+    {
+        if (!FileExist(BANKING_DIR))
+        {
+            MakeDirectory(BANKING_DIR);
+        }
+
+        JsonFileLoader<BankingAccount>.JsonSaveFile(GetLegacyFile(account.SteamID64), account);
+        return true;
+    }
+}
+
+// ============================================================
+// BINARY STORE - Sharded binary records
+// ============================================================
+// Layout: $profile:Banking/Accounts/<shard>/<SteamID64>.bin
+// where shard = hash(SteamID64) % shard count, so no directory holds
+// more than a small fraction of all accounts.
+//
+// Record: magic, format version, then BankingAccount.WriteBinary.
+// Saves go to <file>.tmp first; a load that finds the main file
+// unreadable falls back to the temp file of an interrupted save.
+//
+// Accounts still in the legacy JSON layout are migrated on first
+// load and the JSON file is moved to $profile:Banking/Migrated/.
+
+static const int BANKING_ACCOUNT_MAGIC = 0x42414E4B;  // "BANK"
+static const int BANKING_ACCOUNT_FORMAT_VERSION = 3;  // 2: history as BankingTransactionCodec batch, 3: LastBulkOperation
+
+class BankingBinaryAccountStore : BankingAccountStore
+{
+    static const string ACCOUNTS_DIR = "$profile:Banking/Accounts/";
+    static const string MIGRATED_DIR = "$profile:Banking/Migrated/";
+
+    protected int m_ShardCount;
+    protected ref set<int> m_KnownShards;   // Shard directories already created
+    protected int m_Migrated;
+
+    void BankingBinaryAccountStore(int shardCount)
+    {
+        m_ShardCount = Math.Max(shardCount, 1);
+        m_KnownShards = new set<int>;
+        m_Migrated = 0;
+    }
+
+    override string GetName()
+    {
+        return "binary (" + m_ShardCount.ToString() + " shards)";
+    }
+
+    // ============================================================
+    // PATHS
+    // ============================================================
+    int GetShard(string playerID)
+    {
+        return HashShard(playerID, m_ShardCount);
+    }
+
+    string GetShardDir(int shard)
+    {
+        return ACCOUNTS_DIR + shard.ToStringLen(3) + "/";
+    }
+
+    string GetAccountFile(string playerID)
+    {
+        return GetShardDir(GetShard(playerID)) + playerID + ".bin";
+    }
+
+    // ============================================================
+    // EXISTS
+    // ============================================================
+    override bool Exists(string playerID)
+    {
+        return FileExist(GetAccountFile(playerID)) || FileExist(GetLegacyFile(playerID));
+    }
+
+    // ============================================================
+    // LOAD - Binary record, or migrate legacy JSON
+    // ============================================================
+    override bool Load(string playerID, BankingAccount account)
+    {
+        string filePath = GetAccountFile(playerID);
+
+        if (FileExist(filePath))
+        {
+            if (ReadRecord(filePath, account))
+            {
+                return true;
+            }
+
+            ModLogger.Warning(BANKING_LOG, "Account record unreadable, trying interrupted save: " + filePath);
+            return ReadRecord(filePath + ".tmp", account);
+        }
+
+        return Migrate(playerID, account);
+    }
+
+    override bool Read(string playerID, BankingAccount account)
+    {
+        string filePath = GetAccountFile(playerID);
+
+        if (FileExist(filePath))
+        {
+            return ReadRecord(filePath, account) || ReadRecord(filePath + ".tmp", account);
+        }
+
+        return ReadLegacy(playerID, account);
+    }
+
+    // ============================================================
+    // SAVE - Write temp file, then replace the record
+    // ============================================================
+    override bool Save(BankingAccount account)
+    {
+        int shard = GetShard(account.SteamID64);
+        EnsureShardDir(shard);
+
+        string filePath = GetShardDir(shard) + account.SteamID64 + ".bin";
+        string tempPath = filePath + ".tmp";
+
+        FileSerializer file = new FileSerializer();
+        if (!file.Open(tempPath, FileMode.WRITE))
+        {
+            ModLogger.Error(BANKING_LOG, "Failed to open account record: " + tempPath);
+            return false;
+        }
+
+        file.Write(BANKING_ACCOUNT_MAGIC);
+        file.Write(BANKING_ACCOUNT_FORMAT_VERSION);
+        account.WriteBinary(file);
+        file.Close();
+
+        // Keep the temp file; the account stays dirty and is written again
+        if (!CopyFile(tempPath, filePath))
+        {
+            ModLogger.Error(BANKING_LOG, "Failed to replace account record: " + filePath);
+            return false;
+        }
+
+        DeleteFile(tempPath);
+        return true;
+    }
+
+    // ============================================================
+    // LIST CHUNK - One shard each, then accounts not yet migrated
+    // ============================================================
+    override int GetListChunkCount()
+    {
+        return m_ShardCount + 1;
+    }
+
+    override void ListChunk(int chunk, array<string> result)
+    {
+        if (chunk < m_ShardCount)
+        {
+            ListFiles(GetShardDir(chunk), ".bin", result);
+            return;
+        }
+
+        array<string> legacy = new array<string>;
+        ListLegacyAccounts(legacy);
+
+        foreach (string playerID : legacy)
+        {
+            if (!FileExist(GetAccountFile(playerID)))
+            {
+                result.Insert(playerID);
+            }
+        }
+    }
+
+    int GetMigratedCount()
+    {
+        return m_Migrated;
+    }
+
+    // ============================================================
+    // HELPERS
+    // ============================================================
+    protected bool ReadRecord(string filePath, BankingAccount account)
+    {
+        if (!FileExist(filePath))
+        {
+            return false;
+        }
+
+        FileSerializer file = new FileSerializer();
+        if (!file.Open(filePath, FileMode.READ))
+        {
+            return false;
+        }
+
+        int magic;
+        int version;
+        bool ok = file.Read(magic) && magic == BANKING_ACCOUNT_MAGIC;
+        ok = ok && file.Read(version) && version <= BANKING_ACCOUNT_FORMAT_VERSION;
+        ok = ok && account.ReadBinary(file, version);
+        file.Close();
+
+        return ok;
+    }
+
+    protected bool ReadLegacy(string playerID, BankingAccount account)
+    {
+        string legacyPath = GetLegacyFile(playerID);
+        if (!FileExist(legacyPath))
+        {
+            return false;
+        }
+
+        JsonFileLoader<BankingAccount>.JsonLoadFile(legacyPath, account);
+        account.ConvertLegacyHistory(legacyPath);
+        account.NormalizeHistory();
+        return true;
+    }
+
+    protected bool Migrate(string playerID, BankingAccount account)
+    {
+        if (!ReadLegacy(playerID, account))
+        {
+            return false;
+        }
+
+        string legacyPath = GetLegacyFile(playerID);
+
+        if (!Save(account))
+        {
+            return true;  // Loaded; keep the JSON file and retry next time
+        }
+
+        if (!FileExist(MIGRATED_DIR))
+        {
+            MakeDirectory(MIGRATED_DIR);
+        }
+
+        CopyFile(legacyPath, MIGRATED_DIR + playerID + ".json");
+        DeleteFile(legacyPath);
+        m_Migrated++;
+
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.INFO))
+        {
+            ModLogger.Info(BANKING_LOG, "Account migrated to binary store: " + playerID);
+        }
+
+        return true;
+    }
+
+    protected void EnsureShardDir(int shard)
+    {
+        if (m_KnownShards.Find(shard) >= 0)
+        {
+            return;
+        }
+
+        if (!FileExist(ACCOUNTS_DIR))
+        {
+            MakeDirectory(ACCOUNTS_DIR);
+        }
+
+        string shardDir = GetShardDir(shard);
+        if (!FileExist(shardDir))
+        {
+            MakeDirectory(shardDir);
+        }
+
+        m_KnownShards.Insert(shard);
+    }
+}
+
+// ============================================================
+// ACCOUNT LISTING - ListAccounts spread over several ticks
+// ============================================================
+// A full listing reads every shard directory; scans call Step once
+// per tick until it returns true, then take GetIDs().
+class BankingAccountListing
+{
+    protected ref array<string> m_IDs;
+    protected int m_NextChunk;
+
+    void BankingAccountListing()
+    {
+        m_IDs = new array<string>;
+        m_NextChunk = 0;
+    }
+
+    // Lists at least one chunk, more while budgetMs lasts; true when done
+    bool Step(int budgetMs)
+    {
+        BankingAccountStore store = BankingAccountStore.GetInstance();
+        int chunks = store.GetListChunkCount();
+        int startTicks = TickCount(0);
+
+        while (m_NextChunk < chunks)
+        {
+            store.ListChunk(m_NextChunk, m_IDs);
+            m_NextChunk++;
+
+            // TickCount is in 1/10000 ms units
+            if (TickCount(startTicks) / 10000 >= budgetMs)
+            {
+                break;
+            }
+        }
+
+        return m_NextChunk >= chunks;
+    }
+
+    array<string> GetIDs()
+    {
+        return m_IDs;
+    }
+}
@@ -0,0 +1,274 @@
+// ============================================================
+// BANKING BACKUP MANAGER - Indexed account backups with retention
+// ============================================================
+// Each account has a small manifest listing its backups, so
+// snapshots are taken and pruned without scanning directories.
+// - At most one backup per account every BackupIntervalMinutes
+// - Backups older than BackupRetentionDays are deleted
+// - At most BackupMaxPerAccount backups are kept per account
+//
+// Files in $profile:Banking/Backups/<shard>/:
+//   <SteamID64>.manifest.json  - BankingBackupIndex
+//   <SteamID64>_<n>.bin        - Account snapshot (binary account record)
+
+// ============================================================
+// BACKUP ENTRY - One backup file of one account
+// ============================================================
+class BankingBackupEntry
+{
+    int Number;         // Per-account backup number (part of the file name)
+    int Timestamp;      // UTC seconds since 1970 when the backup was taken
+    int Balance;        // Balance at backup time (for quick inspection)
+}
+
+// ============================================================
+// BACKUP INDEX - Manifest of one account, oldest first
+// ============================================================
+class BankingBackupIndex
+{
+    int NextNumber;
+    ref array<ref BankingBackupEntry> Entries;
+
+    void BankingBackupIndex()
+    {
+        NextNumber = 0;
+        Entries = new array<ref BankingBackupEntry>;
+    }
+
+    int GetLastBackupTime()
+    {
+        if (Entries.Count() == 0)
+        {
+            return 0;
+        }
+
+        return Entries[Entries.Count() - 1].Timestamp;
+    }
+}
+
+class BankingBackupManager
+{
+    static const string BACKUP_DIR = "$profile:Banking/Backups/";
+
+    // Manifests of cached accounts (offline accounts are read per save)
+    protected ref map<string, ref BankingBackupIndex> m_Indexes;
+    protected ref set<int> m_KnownShards;
+
+    private static ref BankingBackupManager m_Instance;
+
+    // ============================================================
+    // GET INSTANCE - Singleton pattern
+    // ============================================================
+    static BankingBackupManager GetInstance()
+    {
+        if (!m_Instance)
+        {
+            m_Instance = new BankingBackupManager();
+        }
+
+        return m_Instance;
+    }
+
+    void BankingBackupManager()
+    {
+        m_Indexes = new map<string, ref BankingBackupIndex>;
+        m_KnownShards = new set<int>;
+    }
+
+    // ============================================================
+    // ON ACCOUNT SAVED - Back up if the interval has passed
+    // ============================================================
+    void OnAccountSaved(BankingAccount account)
+    {
+        BankingConfig config = GetBankingConfig();
+        if (!config.AutoBackup)
+        {
+            return;
+        }
+
+        BankingBackupIndex index = GetIndex(account.SteamID64);
+        int now = BankingClock.GetTimestamp();
+
+        if (index.Entries.Count() > 0 && now - index.GetLastBackupTime() < config.BackupIntervalMinutes * 60)
+        {
+            Release(account.SteamID64);
+            return;
+        }
+
+        // A failed write must not prune the last good backup
+        if (!CreateBackup(account, index, now))
+        {
+            Release(account.SteamID64);
+            return;
+        }
+
+        Prune(account.SteamID64, index, now);
+        SaveIndex(account.SteamID64, index);
+        Release(account.SteamID64);
+    }
+
+    // ============================================================
+    // GET BACKUPS - Manifest entries of one account (oldest first)
+    // ============================================================
+    array<ref BankingBackupEntry> GetBackups(string playerID)
+    {
+        return GetIndex(playerID).Entries;
+    }
+
+    // ============================================================
+    // LOAD BACKUP - Read one backup into account (for admin restore)
+    // ============================================================
+    bool LoadBackup(string playerID, int number, BankingAccount account)
+    {
+        string filePath = GetBackupFile(playerID, number);
+        if (!FileExist(filePath))
+        {
+            return false;
+        }
+
+        FileSerializer file = new FileSerializer();
+        if (!file.Open(filePath, FileMode.READ))
+        {
+            return false;
+        }
+
+        int magic;
+        int version;
+        bool ok = file.Read(magic) && magic == BANKING_ACCOUNT_MAGIC;
+        ok = ok && file.Read(version) && version <= BANKING_ACCOUNT_FORMAT_VERSION;
+        ok = ok && account.ReadBinary(file, version);
+        file.Close();
+
+        return ok;
+    }
+
+    // ============================================================
+    // FORGET - Drop a cached manifest (account left the cache)
+    // ============================================================
+    void Forget(string playerID)
+    {
+        m_Indexes.Remove(playerID);
+    }
+
+    // ============================================================
+    // HELPERS
+    // ============================================================
+    protected bool CreateBackup(BankingAccount account, BankingBackupIndex index, int now)
+    {
+        EnsureShardDir(account.SteamID64);
+
+        BankingBackupEntry entry = new BankingBackupEntry();
+        entry.Number = index.NextNumber;
+        entry.Timestamp = now;
+        entry.Balance = account.Balance;
+
+        FileSerializer file = new FileSerializer();
+        if (!file.Open(GetBackupFile(account.SteamID64, entry.Number), FileMode.WRITE))
+        {
+            ModLogger.Error(BANKING_LOG, "Failed to create backup for " + account.SteamID64);
+            return false;
+        }
+
+        file.Write(BANKING_ACCOUNT_MAGIC);
+        file.Write(BANKING_ACCOUNT_FORMAT_VERSION);
+        account.WriteBinary(file);
+        file.Close();
+        BankingIOStats.BackupWrites++;
+
+        index.NextNumber++;
+        index.Entries.Insert(entry);
+        return true;
+    }
+
+    // Keep manifests only for cached accounts - compaction, bulk
+    // operations and metrics also save offline accounts
+    protected void Release(string playerID)
+    {
+        if (!BankingManager.GetInstance().GetAccountCache().Peek(playerID))
+        {
+            m_Indexes.Remove(playerID);
+        }
+    }
+
+    // Entries are oldest first, so pruning only ever removes from the front
+    protected void Prune(string playerID, BankingBackupIndex index, int now)
+    {
+        BankingConfig config = GetBankingConfig();
+        int cutoff = now - config.BackupRetentionDays * 86400;
+        int maxBackups = Math.Max(config.BackupMaxPerAccount, 1);
+
+        while (index.Entries.Count() > 1)
+        {
+            BankingBackupEntry oldest = index.Entries[0];
+            if (oldest.Timestamp >= cutoff && index.Entries.Count() <= maxBackups)
+            {
+                break;
+            }
+
+            DeleteFile(GetBackupFile(playerID, oldest.Number));
+            index.Entries.RemoveOrdered(0);
+        }
+    }
+
+    protected BankingBackupIndex GetIndex(string playerID)
+    {
+        BankingBackupIndex index = m_Indexes.Get(playerID);
+        if (index)
+        {
+            return index;
+        }
+
+        index = new BankingBackupIndex();
+        string manifestPath = GetManifestFile(playerID);
+        if (FileExist(manifestPath))
+        {
+            JsonFileLoader<BankingBackupIndex>.JsonLoadFile(manifestPath, index);
+        }
+
+        m_Indexes.Set(playerID, index);
+        return index;
+    }
+
+    protected void SaveIndex(string playerID, BankingBackupIndex index)
+    {
+        JsonFileLoader<BankingBackupIndex>.JsonSaveFile(GetManifestFile(playerID), index);
+    }
+
+    protected string GetShardDir(string playerID)
+    {
+        int shard = BankingAccountStore.HashShard(playerID, GetBankingConfig().AccountStoreShards);
+        return BACKUP_DIR + shard.ToStringLen(3) + "/";
+    }
+
+    protected string GetManifestFile(string playerID)
+    {
+        return GetShardDir(playerID) + playerID + ".manifest.json";
+    }
+
+    protected string GetBackupFile(string playerID, int number)
+    {
+        return GetShardDir(playerID) + playerID + "_" + number.ToString() + ".bin";
+    }
+
+    protected void EnsureShardDir(string playerID)
+    {
+        int shard = BankingAccountStore.HashShard(playerID, GetBankingConfig().AccountStoreShards);
+        if (m_KnownShards.Find(shard) >= 0)
+        {
+            return;
+        }
+
+        if (!FileExist(BACKUP_DIR))
+        {
+            MakeDirectory(BACKUP_DIR);
+        }
+
+        string shardDir = GetShardDir(playerID);
+        if (!FileExist(shardDir))
+        {
+            MakeDirectory(shardDir);
+        }
+
+        m_KnownShards.Insert(shard);
+    }
+}
@@ -0,0 +1,392 @@
+// ============================================================
+// BANKING BENCHMARK - Throughput harness for BankingManager
+// ============================================================
+// Creates synthetic accounts and replays a random mix of deposits,
+// withdrawals and transfers through the same account, persistence
+// and cache paths as real transactions (inventory work excluded).
+// Results are appended to $profile:banking_benchmark.csv, one row
+// per operation type plus a total row, so runs with different
+// persistence settings can be compared.
+//
+// Start a server with -bankingBenchmark, or call
+// BankingBenchmark.GetInstance().Start() from an admin tool.
+// Use a test profile: benchmark accounts (BENCH_*) are real accounts.
+
+// ============================================================
+// BENCHMARK SETTINGS - $profile:banking_benchmark.json
+// ============================================================
+class BankingBenchmarkSettings
+{
+    string Label;               // Free text written to the CSV (e.g. "journal")
+    int Accounts;               // Synthetic accounts to create
+    int Operations;             // Operations to replay
+    int OpsPerTick;             // Operations per server frame
+    int DepositWeight;          // Relative share of deposits
+    int WithdrawWeight;         // Relative share of withdrawals
+    int TransferWeight;         // Relative share of transfers
+    int OfflineTransferPercent; // Transfers to accounts that are never loaded
+    int MinAmount;
+    int MaxAmount;
+
+    void BankingBenchmarkSettings()
+    {
+        Label = "default";
+        Accounts = 1000;
+        Operations = 20000;
+        OpsPerTick = 200;
+        DepositWeight = 50;
+        WithdrawWeight = 30;
+        TransferWeight = 20;
+        OfflineTransferPercent = 25;
+        MinAmount = 10;
+        MaxAmount = 1000;
+    }
+}
+
+// ============================================================
+// OPERATION STATS - Samples of one operation type
+// ============================================================
+class BankingBenchmarkOpStats
+{
+    string Name;
+    ref array<int> LatenciesUs;     // One sample per operation (microseconds)
+    int TotalUs;
+    int FileWrites;
+    int Failed;
+
+    void BankingBenchmarkOpStats(string name)
+    {
+        Name = name;
+        LatenciesUs = new array<int>;
+        TotalUs = 0;
+        FileWrites = 0;
+        Failed = 0;
+    }
+
+    void Add(int latencyUs, int fileWrites, bool ok)
+    {
+        LatenciesUs.Insert(latencyUs);
+        TotalUs += latencyUs;
+        FileWrites += fileWrites;
+
+        if (!ok)
+        {
+            Failed++;
+        }
+    }
+
+    // Call after sorting LatenciesUs
+    int GetPercentile(int percent)
+    {
+        int count = LatenciesUs.Count();
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        int index = Math.Min((count * percent) / 100, count - 1);
+        return LatenciesUs[index];
+    }
+}
+
+class BankingBenchmark
+{
+    static const string SETTINGS_FILE = "$profile:banking_benchmark.json";
+    static const string RESULTS_FILE = "$profile:banking_benchmark.csv";
+    static const string ACCOUNT_PREFIX = "BENCH_";
+    static const string OFFLINE_PREFIX = "BENCH_OFF_";
+
+    protected ref BankingBenchmarkSettings m_Settings;
+    protected ref map<string, ref BankingBenchmarkOpStats> m_Stats;
+    protected bool m_IsRunning;
+    protected int m_SetupDone;
+    protected int m_OpsDone;
+    protected int m_RunStartWrites;
+    protected int m_RunStartTime;
+
+    private static ref BankingBenchmark m_Instance;
+
+    // ============================================================
+    // GET INSTANCE - Singleton pattern
+    // ============================================================
+    static BankingBenchmark GetInstance()
+    {
+        if (!m_Instance)
+        {
+            m_Instance = new BankingBenchmark();
+        }
+
+        return m_Instance;
+    }
+
+    // ============================================================
+    // START - Load settings and begin (setup, then replay)
+    // ============================================================
+    void Start()
+    {
+        if (m_IsRunning)
+        {
+            ModLogger.Info(BANKING_LOG, "Benchmark already running.");
+            return;
+        }
+
+        m_Settings = new BankingBenchmarkSettings();
+        if (FileExist(SETTINGS_FILE))
+        {
+            JsonFileLoader<BankingBenchmarkSettings>.JsonLoadFile(SETTINGS_FILE, m_Settings);
+        }
+        else
+        {
+            JsonFileLoader<BankingBenchmarkSettings>.JsonSaveFile(SETTINGS_FILE, m_Settings);
+        }
+
+        m_Stats = new map<string, ref BankingBenchmarkOpStats>;
+        m_Stats.Set("deposit", new BankingBenchmarkOpStats("deposit"));
+        m_Stats.Set("withdraw", new BankingBenchmarkOpStats("withdraw"));
+        m_Stats.Set("transfer", new BankingBenchmarkOpStats("transfer"));
+
+        m_IsRunning = true;
+        m_SetupDone = 0;
+        m_OpsDone = 0;
+
+        ModLogger.Info(BANKING_LOG, "Benchmark '" + m_Settings.Label + "' started: " + m_Settings.Accounts.ToString() + " account(s), " + m_Settings.Operations.ToString() + " operation(s)");
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(Step, 1, true);
+    }
+
+    bool IsRunning()
+    {
+        return m_IsRunning;
+    }
+
+    // ============================================================
+    // STEP - One frame worth of setup or replay
+    // ============================================================
+    protected void Step()
+    {
+        BankingManager manager = BankingManager.GetInstance();
+        int budget = Math.Max(m_Settings.OpsPerTick, 1);
+
+        // Phase 1: create and fund accounts
+        while (budget > 0 && m_SetupDone < m_Settings.Accounts)
+        {
+            string playerID = GetAccountID(m_SetupDone);
+            BankingAccount account = manager.GetPlayerAccount(playerID, playerID);
+            account.Balance = account.MaxBalance / 2;
+            manager.SavePlayerAccount(playerID);
+
+            m_SetupDone++;
+            budget--;
+
+            if (m_SetupDone == m_Settings.Accounts)
+            {
+                // Measurement starts with clean counters
+                manager.FlushAllDirtyAccounts();
+                manager.GetAccountCache().ResetStats();
+                m_RunStartWrites = BankingIOStats.GetTotalWrites();
+                m_RunStartTime = TickCount(0);
+            }
+        }
+
+        // Phase 2: replay the operation mix
+        while (budget > 0 && m_OpsDone < m_Settings.Operations)
+        {
+            RunRandomOperation(manager);
+            m_OpsDone++;
+            budget--;
+        }
+
+        if (m_SetupDone == m_Settings.Accounts && m_OpsDone == m_Settings.Operations)
+        {
+            Finish();
+        }
+    }
+
+    // ============================================================
+    // RUN RANDOM OPERATION - Pick by weight, time, count writes
+    // ============================================================
+    protected void RunRandomOperation(BankingManager manager)
+    {
+        int totalWeight = m_Settings.DepositWeight + m_Settings.WithdrawWeight + m_Settings.TransferWeight;
+        int roll = Math.RandomInt(0, Math.Max(totalWeight, 1));
+        int amount = Math.RandomIntInclusive(m_Settings.MinAmount, m_Settings.MaxAmount);
+        string playerID = GetAccountID(Math.RandomInt(0, m_Settings.Accounts));
+
+        string opName;
+        int writesBefore = BankingIOStats.GetTotalWrites();
+        int start = TickCount(0);
+        bool ok;
+
+        if (roll < m_Settings.DepositWeight)
+        {
+            opName = "deposit";
+            ok = RunDeposit(manager, playerID, amount);
+        }
+        else if (roll < m_Settings.DepositWeight + m_Settings.WithdrawWeight)
+        {
+            opName = "withdraw";
+            ok = RunWithdraw(manager, playerID, amount);
+        }
+        else
+        {
+            opName = "transfer";
+            ok = RunTransfer(manager, playerID, amount);
+        }
+
+        // TickCount is in 100 ns units
+        int latencyUs = TickCount(start) / 10;
+        m_Stats.Get(opName).Add(latencyUs, BankingIOStats.GetTotalWrites() - writesBefore, ok);
+    }
+
+    // ============================================================
+    // OPERATIONS - Account side of DepositMoney/WithdrawMoney/TransferMoney
+    // ============================================================
+    protected bool RunDeposit(BankingManager manager, string playerID, int amount)
+    {
+        BankingAccount account = manager.GetPlayerAccount(playerID, playerID);
+        if (!account.Deposit(amount))
+        {
+            return false;
+        }
+
+        BankingTransaction transaction = new BankingTransaction(playerID, account.PlayerName, amount, BankingTransactionType.DEPOSIT);
+        account.AddTransactionToHistory(transaction);
+        manager.SavePlayerAccount(playerID, transaction);
+        return true;
+    }
+
+    protected bool RunWithdraw(BankingManager manager, string playerID, int amount)
+    {
+        BankingAccount account = manager.GetPlayerAccount(playerID, playerID);
+        if (!account.Withdraw(amount))
+        {
+            return false;
+        }
+
+        BankingTransaction transaction = new BankingTransaction(playerID, account.PlayerName, amount, BankingTransactionType.WITHDRAW);
+        account.AddTransactionToHistory(transaction);
+        manager.SavePlayerAccount(playerID, transaction);
+        return true;
+    }
+
+    protected bool RunTransfer(BankingManager manager, string senderID, int amount)
+    {
+        BankingAccount senderAccount = manager.GetPlayerAccount(senderID, senderID);
+        int fee = GetBankingConfig().CalculateFee(amount);
+        if (!senderAccount.Transfer(amount, fee))
+        {
+            return false;
+        }
+
+        string targetID;
+        if (Math.RandomInt(0, 100) < m_Settings.OfflineTransferPercent)
+        {
+            targetID = OFFLINE_PREFIX + Math.RandomInt(0, m_Settings.Accounts).ToString();
+        }
+        else
+        {
+            targetID = GetAccountID(Math.RandomInt(0, m_Settings.Accounts));
+        }
+
+        BankingTransaction transaction = new BankingTransaction(senderID, senderAccount.PlayerName, amount, BankingTransactionType.TRANSFER);
+        transaction.SetFee(fee);
+        senderAccount.AddTransactionToHistory(transaction);
+
+        manager.CreditTransfer(transaction, targetID);
+        manager.SavePlayerAccount(senderID, transaction);
+        manager.FlushAccount(senderID);
+        return true;
+    }
+
+    // ============================================================
+    // FINISH - Write CSV rows and stop
+    // ============================================================
+    protected void Finish()
+    {
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).Remove(Step);
+        m_IsRunning = false;
+
+        // Deferred writes count towards the total row
+        BankingManager.GetInstance().FlushAllDirtyAccounts();
+        int wallUs = TickCount(m_RunStartTime) / 10;
+        int wallMs = wallUs / 1000;
+        int totalWrites = BankingIOStats.GetTotalWrites() - m_RunStartWrites;
+
+        bool writeHeader = !FileExist(RESULTS_FILE);
+        FileHandle file = OpenFile(RESULTS_FILE, FileMode.APPEND);
+        if (!file)
+        {
+            ModLogger.Error(BANKING_LOG, "Failed to open benchmark results file");
+            return;
+        }
+
+        if (writeHeader)
+        {
+            FPrintln(file, "label,storage,journal,write_behind,accounts,operation,count,failed,ops_per_sec,mean_us,p50_us,p99_us,max_us,file_writes_per_op,cache_hit_rate");
+        }
+
+        BankingOpCsvContext context = new BankingOpCsvContext();
+        context.Prefix = m_Settings.Label + "," + GetBankingConfig().AccountStorage + "," + GetBankingConfig().JournalEnabled.ToString() + "," + GetBankingConfig().WriteBehindEnabled.ToString() + "," + m_Settings.Accounts.ToString();
+        context.HitRate = BankingManager.GetInstance().GetAccountCache().GetHitRate();
+
+        BankingBenchmarkOpStats all = new BankingBenchmarkOpStats("all");
+        foreach (string opName, BankingBenchmarkOpStats stats : m_Stats)
+        {
+            foreach (int latency : stats.LatenciesUs)
+            {
+                all.LatenciesUs.Insert(latency);
+            }
+
+            all.TotalUs += stats.TotalUs;
+            all.Failed += stats.Failed;
+
+            WriteRow(file, context, stats, wallUs, stats.FileWrites);
+        }
+
+        // Total row: all writes, including deferred flushes
+        WriteRow(file, context, all, wallUs, totalWrites);
+        CloseFile(file);
+
+        ModLogger.Info(BANKING_LOG, "Benchmark '" + m_Settings.Label + "' finished in " + wallMs.ToString() + " ms. Results: " + RESULTS_FILE);
+    }
+
+    // Throughput uses the wall time of the whole run, so frames between
+    // ticks count; per-operation latency goes in the mean/percentile columns
+    protected void WriteRow(FileHandle file, BankingOpCsvContext context, BankingBenchmarkOpStats stats, int wallUs, int fileWrites)
+    {
+        stats.LatenciesUs.Sort();
+        int count = stats.LatenciesUs.Count();
+
+        float opsPerSec = 0;
+        float meanUs = 0;
+        float writesPerOp = 0;
+        if (wallUs > 0)
+        {
+            opsPerSec = count * 1000000.0 / wallUs;
+        }
+
+        if (count > 0)
+        {
+            float totalUs = stats.TotalUs;
+            float writes = fileWrites;
+            meanUs = totalUs / count;
+            writesPerOp = writes / count;
+        }
+
+        string row = context.Prefix + "," + stats.Name + "," + count.ToString() + "," + stats.Failed.ToString();
+        row += "," + opsPerSec.ToString() + "," + meanUs.ToString() + "," + stats.GetPercentile(50).ToString() + "," + stats.GetPercentile(99).ToString() + "," + stats.GetPercentile(100).ToString();
+        row += "," + writesPerOp.ToString() + "," + context.HitRate.ToString();
+        FPrintln(file, row);
+    }
+
+    protected string GetAccountID(int index)
+    {
+        return ACCOUNT_PREFIX + index.ToString();
+    }
+}
+
+// Shared CSV columns of one run
+class BankingOpCsvContext
+{
+    string Prefix;
+    float HitRate;
+}
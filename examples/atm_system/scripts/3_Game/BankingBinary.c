@@ -0,0 +1,187 @@
+// ============================================================
+// BANKING BINARY - Byte stream, varints and string interning
+// ============================================================
+// Enforce Script serializers only write whole 32-bit values, so the
+// byte writer packs four bytes into each int word. Varints keep
+// small numbers (amounts, indices, timestamps deltas) to 1-3 bytes.
+// Repeated strings (player IDs and names) are written once in a
+// string table and referenced by index.
+
+// ============================================================
+// BYTE WRITER - Bytes packed little-endian into int words
+// ============================================================
+class BankingByteWriter
+{
+    protected ref array<int> m_Words;
+    protected int m_Current;
+    protected int m_ByteCount;
+
+    void BankingByteWriter()
+    {
+        m_Words = new array<int>;
+        m_Current = 0;
+        m_ByteCount = 0;
+    }
+
+    void WriteByte(int value)
+    {
+        int shift = (m_ByteCount % 4) * 8;
+        m_Current = m_Current | ((value & 0xFF) << shift);
+        m_ByteCount++;
+
+        if (m_ByteCount % 4 == 0)
+        {
+            m_Words.Insert(m_Current);
+            m_Current = 0;
+        }
+    }
+
+    // Unsigned LEB128 - the int is treated as 32 unsigned bits
+    void WriteVarUInt(int value)
+    {
+        while ((value & 0xFFFFFF80) != 0)
+        {
+            WriteByte((value & 0x7F) | 0x80);
+            value = (value >> 7) & 0x01FFFFFF;  // Logical shift
+        }
+
+        WriteByte(value);
+    }
+
+    // Zigzag encoding keeps small negative numbers small
+    void WriteVarInt(int value)
+    {
+        WriteVarUInt((value << 1) ^ (value >> 31));
+    }
+
+    // Flushes the last partial word; returns the packed words
+    array<int> Finish()
+    {
+        if (m_ByteCount % 4 != 0)
+        {
+            m_Words.Insert(m_Current);
+            m_Current = 0;
+        }
+
+        return m_Words;
+    }
+
+    int GetByteCount()
+    {
+        return m_ByteCount;
+    }
+}
+
+// ============================================================
+// BYTE READER - Reads what BankingByteWriter wrote
+// ============================================================
+class BankingByteReader
+{
+    protected array<int> m_Words;
+    protected int m_ByteCount;
+    protected int m_Position;
+
+    void BankingByteReader(array<int> words, int byteCount)
+    {
+        m_Words = words;
+        m_ByteCount = byteCount;
+        m_Position = 0;
+    }
+
+    bool IsEnd()
+    {
+        return m_Position >= m_ByteCount;
+    }
+
+    // Returns -1 past the end
+    int ReadByte()
+    {
+        if (m_Position >= m_ByteCount || m_Position / 4 >= m_Words.Count())
+        {
+            m_Position++;
+            return -1;
+        }
+
+        int word = m_Words[m_Position / 4];
+        int shift = (m_Position % 4) * 8;
+        m_Position++;
+
+        return (word >> shift) & 0xFF;
+    }
+
+    bool ReadVarUInt(out int value)
+    {
+        value = 0;
+        int shift = 0;
+
+        while (shift < 35)
+        {
+            int b = ReadByte();
+            if (b < 0)
+            {
+                return false;
+            }
+
+            value = value | ((b & 0x7F) << shift);
+            if ((b & 0x80) == 0)
+            {
+                return true;
+            }
+
+            shift += 7;
+        }
+
+        return false;  // Malformed
+    }
+
+    bool ReadVarInt(out int value)
+    {
+        int raw;
+        if (!ReadVarUInt(raw))
+        {
+            return false;
+        }
+
+        value = ((raw >> 1) & 0x7FFFFFFF) ^ -(raw & 1);
+        return true;
+    }
+}
+
+// ============================================================
+// STRING TABLE - Each distinct string stored once
+// ============================================================
+class BankingStringTable
+{
+    protected ref map<string, int> m_Index;
+    ref array<string> Strings;
+
+    void BankingStringTable()
+    {
+        m_Index = new map<string, int>;
+        Strings = new array<string>;
+    }
+
+    int Intern(string value)
+    {
+        int index;
+        if (m_Index.Find(value, index))
+        {
+            return index;
+        }
+
+        index = Strings.Count();
+        Strings.Insert(value);
+        m_Index.Set(value, index);
+        return index;
+    }
+
+    string Get(int index)
+    {
+        if (index < 0 || index >= Strings.Count())
+        {
+            return "";
+        }
+
+        return Strings[index];
+    }
+}
@@ -0,0 +1,517 @@
+// ============================================================
+// BANKING BULK OPERATION - Apply a change to every stored account
+// ============================================================
+// Wipes, interest payouts and balance caps touch every account.
+// Instead of loading all of them at once, the operation first lists
+// the store shard by shard, then walks the account list in slices of
+// at most BulkOperationMaxPerTick accounts; both phases stop after
+// BulkOperationBudgetMs per tick.
+//
+// Accounts already in the account cache are changed there; all
+// others are read from the store (plus journal) and written back
+// without entering the cache, so online players' accounts are not
+// evicted. Ledger credits an offline account has not received yet
+// are applied on its next load, after the change.
+//
+// Progress is checkpointed every CHECKPOINT_INTERVAL_MS:
+//   bulk_operation.json     - Transform, value, cursor, counters
+//   bulk_operation_ids.txt  - Account list taken at start (sorted)
+// An interrupted operation resumes on the next server start. Every
+// changed account records the operation ID (LastBulkOperation), so
+// accounts processed after the last checkpoint are not changed twice.
+//
+// Accounts created after their shard was listed are not included.
+
+// ============================================================
+// BULK TRANSFORM - Change applied to each account
+// ============================================================
+// Subclass and pass the class name to BankingBulkOperation.Start;
+// the name and value are stored in the checkpoint so the transform
+// can be recreated on resume.
+class BankingBulkTransform
+{
+    protected float m_Value;
+
+    void Init(float value)
+    {
+        m_Value = value;
+    }
+
+    float GetValue()
+    {
+        return m_Value;
+    }
+
+    // Returns true if the account was changed
+    bool Apply(BankingAccount account)
+    {
+        return false;
+    }
+}
+
+// Balance reset to Value (0 = full wipe)
+class BankingWipeTransform : BankingBulkTransform
+{
+    override bool Apply(BankingAccount account)
+    {
+        int balance = Math.Min(m_Value, account.MaxBalance);
+        if (account.Balance == balance && account.DailyWithdrawn == 0)
+        {
+            return false;
+        }
+
+        account.Balance = balance;
+        account.DailyWithdrawn = 0;
+        return true;
+    }
+}
+
+// Interest of Value percent, limited by MaxBalance
+class BankingInterestTransform : BankingBulkTransform
+{
+    override bool Apply(BankingAccount account)
+    {
+        int interest = Math.Floor(account.Balance * m_Value / 100.0);
+        interest = Math.Min(interest, account.MaxBalance - account.Balance);
+        if (interest <= 0)
+        {
+            return false;
+        }
+
+        account.Balance += interest;
+        return true;
+    }
+}
+
+// MaxBalance set to Value, balances above it are cut
+class BankingBalanceCapTransform : BankingBulkTransform
+{
+    override bool Apply(BankingAccount account)
+    {
+        int cap = m_Value;
+        if (account.MaxBalance == cap && account.Balance <= cap)
+        {
+            return false;
+        }
+
+        account.MaxBalance = cap;
+        account.Balance = Math.Min(account.Balance, cap);
+        return true;
+    }
+}
+
+// ============================================================
+// CHECKPOINT - bulk_operation.json
+// ============================================================
+class BankingBulkCheckpoint
+{
+    int OperationID;        // Increases with every started operation
+    string Transform;       // BankingBulkTransform class name
+    float Value;
+    bool Running;
+    bool Listing;           // Account list not complete yet (restarts on resume)
+    int Cursor;             // Next index into the account list
+    int Total;
+    int Modified;
+    int StartedAt;          // UTC timestamp
+
+    void BankingBulkCheckpoint()
+    {
+        OperationID = 0;
+        Running = false;
+    }
+}
+
+class BankingBulkOperation
+{
+    static const string CHECKPOINT_FILE = "$profile:Banking/bulk_operation.json";
+    static const string IDS_FILE = "$profile:Banking/bulk_operation_ids.txt";
+    static const int PROGRESS_LOG_INTERVAL_MS = 10000;
+    static const int CHECKPOINT_INTERVAL_MS = 5000;
+
+    protected ref BankingBulkCheckpoint m_Checkpoint;
+    protected ref BankingBulkTransform m_Transform;
+    protected ref array<string> m_AccountIDs;
+    protected ref BankingAccountListing m_Listing;
+
+    // Rate since this server start (for the ETA)
+    protected int m_ResumeCursor;
+    protected int m_ResumeTime;
+    protected int m_LastProgressLog;
+    protected int m_LastCheckpoint;
+
+    private static ref BankingBulkOperation m_Instance;
+
+    // ============================================================
+    // GET INSTANCE - Singleton pattern
+    // ============================================================
+    static BankingBulkOperation GetInstance()
+    {
+        if (!m_Instance)
+        {
+            m_Instance = new BankingBulkOperation();
+        }
+
+        return m_Instance;
+    }
+
+    void BankingBulkOperation()
+    {
+        m_Checkpoint = new BankingBulkCheckpoint();
+
+        if (FileExist(CHECKPOINT_FILE))
+        {
+            JsonFileLoader<BankingBulkCheckpoint>.JsonLoadFile(CHECKPOINT_FILE, m_Checkpoint);
+        }
+    }
+
+    // ============================================================
+    // START - Begin a new operation (false if one is running)
+    // ============================================================
+    bool Start(string transformClass, float value)
+    {
+        if (m_Checkpoint.Running)
+        {
+            ModLogger.Warning(BANKING_LOG, "Bulk operation already running: " + GetProgress());
+            return false;
+        }
+
+        BankingBulkTransform transform = CreateTransform(transformClass, value);
+        if (!transform)
+        {
+            ModLogger.Error(BANKING_LOG, "Unknown bulk transform: " + transformClass);
+            return false;
+        }
+
+        m_Transform = transform;
+        m_Checkpoint.OperationID++;
+        m_Checkpoint.Transform = transformClass;
+        m_Checkpoint.Value = value;
+        m_Checkpoint.Running = true;
+        m_Checkpoint.Listing = true;
+        m_Checkpoint.Cursor = 0;
+        m_Checkpoint.Total = 0;
+        m_Checkpoint.Modified = 0;
+        m_Checkpoint.StartedAt = BankingClock.GetTimestamp();
+        SaveCheckpoint();
+
+        ModLogger.Info(BANKING_LOG, "Bulk operation #" + m_Checkpoint.OperationID.ToString() + " started: " + transformClass + "(" + value.ToString() + "), listing accounts");
+        m_Listing = new BankingAccountListing();
+        Schedule();
+        return true;
+    }
+
+    // ============================================================
+    // RESUME - Continue an interrupted operation (server start)
+    // ============================================================
+    void Resume()
+    {
+        if (!m_Checkpoint.Running || m_Transform)
+        {
+            return;
+        }
+
+        m_Transform = CreateTransform(m_Checkpoint.Transform, m_Checkpoint.Value);
+
+        // Interrupted while listing - list again (nothing was changed yet)
+        if (m_Transform && m_Checkpoint.Listing)
+        {
+            ModLogger.Info(BANKING_LOG, "Bulk operation #" + m_Checkpoint.OperationID.ToString() + " resumed, listing accounts");
+            m_Listing = new BankingAccountListing();
+            Schedule();
+            return;
+        }
+
+        if (!m_Transform || !ReadAccountList())
+        {
+            ModLogger.Error(BANKING_LOG, "Cannot resume bulk operation #" + m_Checkpoint.OperationID.ToString() + ", cancelled");
+            m_Transform = null;
+            m_Checkpoint.Running = false;
+            SaveCheckpoint();
+            return;
+        }
+
+        ModLogger.Info(BANKING_LOG, "Bulk operation resumed: " + GetProgress());
+        Schedule();
+    }
+
+    // ============================================================
+    // CANCEL - Stop after the current slice; done accounts stay changed
+    // ============================================================
+    void Cancel()
+    {
+        if (!m_Checkpoint.Running)
+        {
+            return;
+        }
+
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).Remove(Step);
+        m_Checkpoint.Running = false;
+        m_Checkpoint.Listing = false;
+        SaveCheckpoint();
+        m_Transform = null;
+        m_AccountIDs = null;
+        m_Listing = null;
+
+        ModLogger.Info(BANKING_LOG, "Bulk operation #" + m_Checkpoint.OperationID.ToString() + " cancelled at " + m_Checkpoint.Cursor.ToString() + "/" + m_Checkpoint.Total.ToString());
+    }
+
+    bool IsRunning()
+    {
+        return m_Checkpoint.Running;
+    }
+
+    // ============================================================
+    // STEP - Process one slice under the time budget
+    // ============================================================
+    protected void Step()
+    {
+        BankingConfig config = GetBankingConfig();
+        int maxAccounts = Math.Max(config.BulkOperationMaxPerTick, 1);
+        int budgetMs = config.BulkOperationBudgetMs;
+
+        if (m_Listing)
+        {
+            if (m_Listing.Step(budgetMs))
+            {
+                FinishListing();
+            }
+
+            return;
+        }
+
+        int startTicks = TickCount(0);
+        int processed = 0;
+
+        while (m_Checkpoint.Cursor < m_AccountIDs.Count() && processed < maxAccounts)
+        {
+            ProcessAccount(m_AccountIDs[m_Checkpoint.Cursor]);
+            m_Checkpoint.Cursor++;
+            processed++;
+
+            // TickCount is in 1/10000 ms units
+            if (TickCount(startTicks) / 10000 >= budgetMs)
+            {
+                break;
+            }
+        }
+
+        if (m_Checkpoint.Cursor >= m_AccountIDs.Count())
+        {
+            Finish();
+            return;
+        }
+
+        // Accounts done since the last checkpoint are skipped on resume
+        int now = GetGame().GetTime();
+        if (now - m_LastCheckpoint >= CHECKPOINT_INTERVAL_MS)
+        {
+            m_LastCheckpoint = now;
+            SaveCheckpoint();
+        }
+
+        if (now - m_LastProgressLog >= PROGRESS_LOG_INTERVAL_MS)
+        {
+            m_LastProgressLog = now;
+            ModLogger.Info(BANKING_LOG, "Bulk operation: " + GetProgress());
+        }
+    }
+
+    // Account list complete: store it, then start processing next tick
+    protected void FinishListing()
+    {
+        m_AccountIDs = m_Listing.GetIDs();
+        m_AccountIDs.Sort();
+        m_Listing = null;
+
+        if (!WriteAccountList())
+        {
+            Cancel();
+            return;
+        }
+
+        m_Checkpoint.Listing = false;
+        m_Checkpoint.Total = m_AccountIDs.Count();
+        SaveCheckpoint();
+
+        // ETA counts processing only
+        m_ResumeTime = GetGame().GetTime();
+
+        ModLogger.Info(BANKING_LOG, "Bulk operation #" + m_Checkpoint.OperationID.ToString() + ": " + m_Checkpoint.Total.ToString() + " account(s) to process");
+    }
+
+    protected void ProcessAccount(string playerID)
+    {
+        BankingManager manager = BankingManager.GetInstance();
+        bool cached = manager.GetAccountCache().Peek(playerID) != null;
+
+        // Cached account, or a read-only copy that is not cached
+        BankingAccount account = manager.ReadAccount(playerID);
+        if (!account)
+        {
+            return;  // Deleted since the operation started
+        }
+
+        // Changed before the last checkpoint was written
+        if (account.LastBulkOperation >= m_Checkpoint.OperationID)
+        {
+            return;
+        }
+
+        int oldBalance = account.Balance;
+        if (!m_Transform.Apply(account))
+        {
+            return;  // No-op - safe to repeat, no write needed
+        }
+
+        account.LastBulkOperation = m_Checkpoint.OperationID;
+        m_Checkpoint.Modified++;
+
+        if (cached)
+        {
+            manager.SavePlayerAccount(playerID);
+            manager.FlushAccount(playerID);
+        }
+        else
+        {
+            manager.WriteAccount(account, oldBalance);
+        }
+    }
+
+    protected void Finish()
+    {
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).Remove(Step);
+        m_Checkpoint.Running = false;
+        SaveCheckpoint();
+        DeleteFile(IDS_FILE);
+
+        ModLogger.Info(BANKING_LOG, "Bulk operation #" + m_Checkpoint.OperationID.ToString() + " finished: " + m_Checkpoint.Modified.ToString() + " of " + m_Checkpoint.Total.ToString() + " account(s) changed");
+
+        m_Transform = null;
+        m_AccountIDs = null;
+    }
+
+    // ============================================================
+    // GET PROGRESS - "processed/total (percent), changed, ETA"
+    // ============================================================
+    string GetProgress()
+    {
+        BankingBulkCheckpoint cp = m_Checkpoint;
+        string text = "#" + cp.OperationID.ToString() + " " + cp.Transform + "(" + cp.Value.ToString() + ") ";
+
+        int percent = 100;
+        if (cp.Total > 0)
+        {
+            percent = cp.Cursor * 100 / cp.Total;
+        }
+
+        text += cp.Cursor.ToString() + "/" + cp.Total.ToString() + " (" + percent.ToString() + "%), " + cp.Modified.ToString() + " changed";
+
+        if (!cp.Running)
+        {
+            return text + ", not running";
+        }
+
+        if (cp.Listing)
+        {
+            return text + ", listing accounts";
+        }
+
+        int eta = GetEtaSeconds();
+        if (eta >= 0)
+        {
+            text += ", ETA " + (eta / 60).ToString() + "m " + (eta % 60).ToString() + "s";
+        }
+
+        return text;
+    }
+
+    // Seconds left at the rate since this server start (-1 = unknown)
+    int GetEtaSeconds()
+    {
+        int done = m_Checkpoint.Cursor - m_ResumeCursor;
+        int elapsedMs = GetGame().GetTime() - m_ResumeTime;
+        if (done <= 0 || elapsedMs <= 0)
+        {
+            return -1;
+        }
+
+        float msPerAccount = elapsedMs / (float)done;
+        return (m_Checkpoint.Total - m_Checkpoint.Cursor) * msPerAccount / 1000;
+    }
+
+    // ============================================================
+    // HELPERS
+    // ============================================================
+    static BankingBulkTransform CreateTransform(string transformClass, float value)
+    {
+        typename type = transformClass.ToType();
+        if (!type || !type.IsInherited(BankingBulkTransform))
+        {
+            return null;
+        }
+
+        BankingBulkTransform transform = BankingBulkTransform.Cast(type.Spawn());
+        if (transform)
+        {
+            transform.Init(value);
+        }
+
+        return transform;
+    }
+
+    protected void Schedule()
+    {
+        m_ResumeCursor = m_Checkpoint.Cursor;
+        m_ResumeTime = GetGame().GetTime();
+        m_LastProgressLog = m_ResumeTime;
+        m_LastCheckpoint = m_ResumeTime;
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(Step, 1, true);
+    }
+
+    protected void SaveCheckpoint()
+    {
+        JsonFileLoader<BankingBulkCheckpoint>.JsonSaveFile(CHECKPOINT_FILE, m_Checkpoint);
+    }
+
+    protected bool WriteAccountList()
+    {
+        FileHandle file = OpenFile(IDS_FILE, FileMode.WRITE);
+        if (!file)
+        {
+            ModLogger.Error(BANKING_LOG, "Failed to write bulk operation account list");
+            return false;
+        }
+
+        foreach (string playerID : m_AccountIDs)
+        {
+            FPrintln(file, playerID);
+        }
+
+        CloseFile(file);
+        return true;
+    }
+
+    protected bool ReadAccountList()
+    {
+        FileHandle file = OpenFile(IDS_FILE, FileMode.READ);
+        if (!file)
+        {
+            return false;
+        }
+
+        m_AccountIDs = new array<string>;
+        string line;
+        while (FGets(file, line) >= 0)
+        {
+            line.Trim();
+            if (line != "")
+            {
+                m_AccountIDs.Insert(line);
+            }
+        }
+
+        CloseFile(file);
+        return m_AccountIDs.Count() == m_Checkpoint.Total;
+    }
+}
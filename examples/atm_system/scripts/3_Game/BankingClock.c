@@ -0,0 +1,43 @@
+// ============================================================
+// BANKING CLOCK - Wall clock time that survives restarts
+// ============================================================
+// GetGame().GetTickTime() restarts with the server; backups,
+// daily metrics and bulk operation checkpoints need UTC time.
+
+class BankingClock
+{
+    static const int SECONDS_PER_DAY = 86400;
+
+    // ============================================================
+    // GET TIMESTAMP - UTC seconds since 1970
+    // ============================================================
+    static int GetTimestamp()
+    {
+        int year, month, day, hour, minute, second;
+        GetYearMonthDayUTC(year, month, day);
+        GetHourMinuteSecondUTC(hour, minute, second);
+
+        // Days since 1970-01-01 (civil calendar, year >= 1970)
+        if (month <= 2)
+        {
+            year--;
+            month += 12;
+        }
+
+        int era = year / 400;
+        int yearOfEra = year - era * 400;
+        int dayOfYear = (153 * (month - 3) + 2) / 5 + day - 1;
+        int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        int days = era * 146097 + dayOfEra - 719468;
+
+        return days * SECONDS_PER_DAY + hour * 3600 + minute * 60 + second;
+    }
+
+    // ============================================================
+    // GET DAY - Days since 1970-01-01 (UTC)
+    // ============================================================
+    static int GetDay()
+    {
+        return GetTimestamp() / SECONDS_PER_DAY;
+    }
+}
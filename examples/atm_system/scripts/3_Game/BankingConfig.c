@@ -3,6 +3,15 @@
 // ============================================================
 // This class loads and manages banking system settings
 // Settings are stored in banking_config.json
+//
+// Each load produces a compiled snapshot: lookup tables and derived
+// values are built once and the instance is not modified afterwards.
+// Reload builds a new instance and swaps it in, so code holding the
+// old one keeps seeing a consistent config. GetGeneration() changes
+// on every effective reload.
+
+// ModLogger module name for everything the ATM system logs
+static const string BANKING_LOG = "ATM System";
 
 class BankingConfig
 {
@@ -15,17 +24,70 @@ class BankingConfig
     int MaxSingleTransaction;
     int DailyWithdrawalLimit;
     int TransactionQueueSize;
+    int TransactionQueueIntervalMs;
+    int TransactionQueueDrainCount;
+    int TransactionQueueBudgetMs;
     bool BankingLogs;
     ref TStringArray CurrenciesAccepted;
+    ref map<string, int> CurrencyValues;
+    ref TStringArray WithdrawCurrencies;
+    string OverflowContainerClass;
     bool AutoBackup;
     int BackupRetentionDays;
+    int BackupIntervalMinutes;
+    int BackupMaxPerAccount;
     bool ShowBalanceOnTransaction;
     bool ShowTransactionFee;
     bool NotifyOnReceive;
     bool NotifyOnSend;
+    bool WriteBehindEnabled;
+    int FlushIntervalMs;
+    int FlushMaxAccountsPerTick;
+    int FlushTimeBudgetMs;
+    bool JournalEnabled;
+    int JournalCompactIntervalMs;
+    int JournalCompactAccountsPerTick;
+    int AccountCacheCapacity;
+    int TransactionHistorySize;
+    int HistoryPageSizeMax;
+    string AccountStorage;
+    bool RpcRateLimitEnabled;
+    int RpcBurst;
+    float RpcRefillPerSecond;
+    bool RpcCoalesceEnabled;
+    int AccountStoreShards;
+    ref TStringArray AdminIDs;
+    int MetricsTopK;
+    int BulkOperationBudgetMs;
+    int BulkOperationMaxPerTick;
+
+    static const string CONFIG_PATH = "$profile:banking_config.json";
+
+    // Accepted currency class -> unit value (built on load, not saved)
+    [NonSerialized()]
+    protected ref map<string, int> m_CurrencyValueTable;
+
+    // Derived values (built on load, not saved)
+    [NonSerialized()]
+    protected float m_FeeRate;
+    [NonSerialized()]
+    protected int m_MinAmount;
+    [NonSerialized()]
+    protected int m_MaxAmount;
+    [NonSerialized()]
+    protected ref set<string> m_AdminSet;
+
+    // Snapshot identity
+    [NonSerialized()]
+    protected int m_Generation;
+    [NonSerialized()]
+    protected int m_SourceLength;
+    [NonSerialized()]
+    protected int m_SourceHash;
 
     // Singleton instance
     private static ref BankingConfig m_Instance;
+    private static int s_LastGeneration;
 
     // ============================================================
     // GET INSTANCE - Singleton pattern
@@ -55,14 +117,52 @@ class BankingConfig
         MaxSingleTransaction = 50000;
         DailyWithdrawalLimit = 0;  // No limit
         TransactionQueueSize = 100;
+        TransactionQueueIntervalMs = 100;
+        TransactionQueueDrainCount = 20;
+        TransactionQueueBudgetMs = 2;
         BankingLogs = false;
         CurrenciesAccepted = new TStringArray;
+        CurrencyValues = new map<string, int>;
+        CurrencyValues.Set("Coin_10", 10);
+        CurrencyValues.Set("Coin_50", 50);
+        CurrencyValues.Set("Coin_100", 100);
+        CurrencyValues.Set("Money_Ruble", 1000);
+        CurrencyValues.Set("Money_Dollar", 100);
+        m_CurrencyValueTable = new map<string, int>;
+        WithdrawCurrencies = new TStringArray;
+        WithdrawCurrencies.Insert("Coin_100");
+        WithdrawCurrencies.Insert("Coin_50");
+        WithdrawCurrencies.Insert("Coin_10");
+        OverflowContainerClass = "WoodenCrate";
         AutoBackup = true;
         BackupRetentionDays = 7;
+        BackupIntervalMinutes = 60;
+        BackupMaxPerAccount = 24;
         ShowBalanceOnTransaction = true;
         ShowTransactionFee = true;
         NotifyOnReceive = true;
         NotifyOnSend = true;
+        WriteBehindEnabled = true;
+        FlushIntervalMs = 5000;  // 5 seconds
+        FlushMaxAccountsPerTick = 8;
+        FlushTimeBudgetMs = 4;
+        JournalEnabled = true;
+        JournalCompactIntervalMs = 600000;  // 10 minutes
+        JournalCompactAccountsPerTick = 5;
+        AccountCacheCapacity = 256;
+        TransactionHistorySize = 100;
+        HistoryPageSizeMax = 25;
+        AccountStorage = "binary";
+        RpcRateLimitEnabled = true;
+        RpcBurst = 5;
+        RpcRefillPerSecond = 2.0;
+        RpcCoalesceEnabled = true;
+        AccountStoreShards = 256;
+        AdminIDs = new TStringArray;
+        MetricsTopK = 10;
+        BulkOperationBudgetMs = 4;
+        BulkOperationMaxPerTick = 50;
+        m_AdminSet = new set<string>;
     }
 
     // ============================================================
@@ -70,24 +170,133 @@ class BankingConfig
     // ============================================================
     void Load()
     {
-        string configPath = "$profile:banking_config.json";
+        string configPath = CONFIG_PATH;
+        string content;
 
         // Check if config file exists
         if (FileExist(configPath))
         {
             // Load from JSON
-            JsonFileLoader<BankingConfig>.JsonLoadFile(configPath, this);
+            content = ReadConfigFile(configPath);
+            if (!Parse(content))
+            {
+                ModLogger.Error(BANKING_LOG, "Invalid configuration, using defaults: " + configPath);
+            }
 
-            Print("[ATM System] Configuration loaded from: " + configPath);
-            Print("[ATM System] RequireCreditCard: " + RequireCreditCard.ToString());
-            Print("[ATM System] TransactionFee: " + TransactionFee.ToString());
-            Print("[ATM System] DefaultMaxBalance: " + DefaultMaxBalance.ToString());
+            ModLogger.Info(BANKING_LOG, "Configuration loaded from: " + configPath);
+            ModLogger.Info(BANKING_LOG, "RequireCreditCard: " + RequireCreditCard.ToString());
+            ModLogger.Info(BANKING_LOG, "TransactionFee: " + TransactionFee.ToString());
+            ModLogger.Info(BANKING_LOG, "DefaultMaxBalance: " + DefaultMaxBalance.ToString());
         }
         else
         {
             // Create default config file
             Save();
-            Print("[ATM System] Configuration file not found. Created default configuration at: " + configPath);
+            ModLogger.Info(BANKING_LOG, "Configuration file not found. Created default configuration at: " + configPath);
+        }
+
+        Compile(content);
+    }
+
+    // ============================================================
+    // PARSE - Fill this instance from config file text
+    // ============================================================
+    protected bool Parse(string content)
+    {
+        JsonSerializer serializer = new JsonSerializer();
+        string error;
+        if (!serializer.ReadFromString(this, content, error))
+        {
+            ModLogger.Error(BANKING_LOG, "Config parse error: " + error);
+            return false;
+        }
+
+        return true;
+    }
+
+    // ============================================================
+    // COMPILE - Build lookup tables and derived values
+    // ============================================================
+    protected void Compile(string content)
+    {
+        BuildCurrencyValueTable();
+
+        m_FeeRate = Math.Clamp(TransactionFee, 0, 1);
+        m_MinAmount = Math.Max(MinTransactionAmount, 1);
+        m_MaxAmount = MaxSingleTransaction;
+
+        // History is a ring buffer indexed modulo this size
+        TransactionHistorySize = Math.Max(TransactionHistorySize, 1);
+
+        m_AdminSet = new set<string>;
+        if (AdminIDs)
+        {
+            foreach (string adminID : AdminIDs)
+            {
+                m_AdminSet.Insert(adminID);
+            }
+        }
+
+        // BankingLogs picks the level unless logger.json sets one
+        ModLogger.GetInstance().SetModuleDefault(BANKING_LOG, BankingLogs ? ModLogLevel.INFO : ModLogLevel.WARNING);
+
+        m_SourceLength = content.Length();
+        m_SourceHash = content.Hash();
+        m_Generation = ++s_LastGeneration;
+    }
+
+    // ============================================================
+    // READ CONFIG FILE - Whole file as text
+    // ============================================================
+    protected static string ReadConfigFile(string configPath)
+    {
+        string content;
+        FileHandle file = OpenFile(configPath, FileMode.READ);
+        if (!file)
+        {
+            return content;
+        }
+
+        string line;
+        while (FGets(file, line) >= 0)
+        {
+            content += line + "\n";
+        }
+
+        CloseFile(file);
+        return content;
+    }
+
+    // ============================================================
+    // BUILD CURRENCY VALUE TABLE - Precompute accepted class values
+    // ============================================================
+    // Values come from CurrencyValues. Accepted "Coin_<n>" classes
+    // without an entry fall back to the number in the class name.
+    protected void BuildCurrencyValueTable()
+    {
+        m_CurrencyValueTable = new map<string, int>;
+
+        foreach (string className : CurrenciesAccepted)
+        {
+            int value = 0;
+
+            if (CurrencyValues && CurrencyValues.Contains(className))
+            {
+                value = CurrencyValues.Get(className);
+            }
+            else if (className.IndexOf("Coin_") == 0)
+            {
+                value = className.Substring(5, className.Length() - 5).ToInt();
+            }
+
+            if (value > 0)
+            {
+                m_CurrencyValueTable.Set(className, value);
+            }
+            else
+            {
+                ModLogger.Warning(BANKING_LOG, "No value for accepted currency " + className);
+            }
         }
     }
 
@@ -96,9 +305,9 @@ class BankingConfig
     // ============================================================
     void Save()
     {
-        string configPath = "$profile:banking_config.json";
+        string configPath = CONFIG_PATH;
         JsonFileLoader<BankingConfig>.JsonSaveFile(configPath, this);
-        Print("[ATM System] Configuration saved to: " + configPath);
+        ModLogger.Info(BANKING_LOG, "Configuration saved to: " + configPath);
     }
 
     // ============================================================
@@ -106,8 +315,52 @@ class BankingConfig
     // ============================================================
     void Reload()
     {
-        Load();
-        Print("[ATM System] Configuration reloaded.");
+        ReloadConfig();
+    }
+
+    // Swaps in a new snapshot; returns false if the file is missing,
+    // invalid or unchanged (same length and hash) and force is not set
+    static bool ReloadConfig(bool force = false)
+    {
+        if (!FileExist(CONFIG_PATH))
+        {
+            ModLogger.Info(BANKING_LOG, "Configuration file not found, keeping current configuration.");
+            return false;
+        }
+
+        string content = ReadConfigFile(CONFIG_PATH);
+
+        if (m_Instance && !force && m_Instance.IsSameSource(content))
+        {
+            ModLogger.Info(BANKING_LOG, "Configuration unchanged (generation " + m_Instance.GetGeneration().ToString() + ").");
+            return false;
+        }
+
+        BankingConfig config = new BankingConfig();
+        if (!config.Parse(content))
+        {
+            ModLogger.Error(BANKING_LOG, "Invalid configuration, keeping current configuration.");
+            return false;
+        }
+
+        config.Compile(content);
+        m_Instance = config;
+
+        ModLogger.Info(BANKING_LOG, "Configuration reloaded (generation " + config.GetGeneration().ToString() + ").");
+        return true;
+    }
+
+    // ============================================================
+    // SNAPSHOT IDENTITY
+    // ============================================================
+    int GetGeneration()
+    {
+        return m_Generation;
+    }
+
+    protected bool IsSameSource(string content)
+    {
+        return content.Length() == m_SourceLength && content.Hash() == m_SourceHash;
     }
 
     // ============================================================
@@ -115,7 +368,7 @@ class BankingConfig
     // ============================================================
     int CalculateFee(int amount)
     {
-        return Math.Floor(amount * TransactionFee);
+        return Math.Floor(amount * m_FeeRate);
     }
 
     // ============================================================
@@ -123,12 +376,12 @@ class BankingConfig
     // ============================================================
     bool IsValidTransactionAmount(int amount)
     {
-        if (amount < MinTransactionAmount)
+        if (amount < m_MinAmount)
         {
             return false;  // Too small
         }
 
-        if (amount > MaxSingleTransaction)
+        if (amount > m_MaxAmount)
         {
             return false;  // Too large
         }
@@ -136,12 +389,28 @@ class BankingConfig
         return true;
     }
 
+    // ============================================================
+    // IS ADMIN - Steam64 ID listed in AdminIDs
+    // ============================================================
+    bool IsAdmin(string playerID)
+    {
+        return m_AdminSet.Find(playerID) >= 0;
+    }
+
     // ============================================================
     // CHECK IF CURRENCY IS ACCEPTED
     // ============================================================
     bool IsCurrencyAccepted(string currencyClassName)
     {
-        return CurrenciesAccepted.Find(currencyClassName) >= 0;
+        return m_CurrencyValueTable.Contains(currencyClassName);
+    }
+
+    // ============================================================
+    // GET CURRENCY VALUE - Unit value of accepted currency (0 = not accepted)
+    // ============================================================
+    int GetCurrencyValue(string currencyClassName)
+    {
+        return m_CurrencyValueTable.Get(currencyClassName);
     }
 }
 
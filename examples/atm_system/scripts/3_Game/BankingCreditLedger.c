@@ -0,0 +1,304 @@
+// ============================================================
+// BANKING CREDIT LEDGER - Pending credits for offline players
+// ============================================================
+// Transfers to a player whose account is not loaded append one
+// line here instead of loading and rewriting the target account.
+// Credits are folded into the balance the next time the account
+// is loaded (BankingManager.GetPlayerAccount).
+//
+// Files in $profile:Banking/:
+//   pending_credits.log        - Append-only credits (one JSON per line)
+//   pending_credits_state.json - Last issued sequence number
+//
+// Every account remembers the last credit it received
+// (BankingAccount.LastCreditSeq), so a credit that is still in the
+// log after a crash is never applied twice.
+
+// ============================================================
+// PENDING CREDIT - One transfer waiting for its recipient
+// ============================================================
+class BankingPendingCredit
+{
+    int Seq;                // Ledger-wide sequence number
+    string TargetID;        // Recipient (Steam64 ID)
+    string SenderID;        // Sender (Steam64 ID)
+    string SenderName;      // Sender name (for history)
+    int Amount;             // Amount to credit
+    int Timestamp;          // When the transfer was made
+}
+
+// ============================================================
+// LEDGER STATE - Survives log rewrites
+// ============================================================
+class BankingCreditLedgerState
+{
+    int LastSeq;
+
+    void BankingCreditLedgerState()
+    {
+        LastSeq = 0;
+    }
+}
+
+class BankingCreditLedger
+{
+    static const string LEDGER_DIR = "$profile:Banking/";
+    static const string LEDGER_FILE = "$profile:Banking/pending_credits.log";
+    static const string LEDGER_TEMP_FILE = "$profile:Banking/pending_credits.tmp";
+    static const string STATE_FILE = "$profile:Banking/pending_credits_state.json";
+
+    // Settled credits tolerated in the log before it is rewritten
+    static const int REWRITE_THRESHOLD = 64;
+
+    protected ref BankingCreditLedgerState m_State;
+
+    // Unsettled credits per recipient, oldest first
+    protected ref map<string, ref array<ref BankingPendingCredit>> m_Pending;
+    protected int m_PendingCount;
+    protected int m_SettledSinceRewrite;
+
+    // ============================================================
+    // CONSTRUCTOR - Read existing ledger
+    // ============================================================
+    void BankingCreditLedger()
+    {
+        m_State = new BankingCreditLedgerState();
+        m_Pending = new map<string, ref array<ref BankingPendingCredit>>;
+        m_PendingCount = 0;
+        m_SettledSinceRewrite = 0;
+
+        if (!FileExist(LEDGER_DIR))
+        {
+            MakeDirectory(LEDGER_DIR);
+        }
+
+        if (FileExist(STATE_FILE))
+        {
+            JsonFileLoader<BankingCreditLedgerState>.JsonLoadFile(STATE_FILE, m_State);
+        }
+
+        Replay();
+    }
+
+    // ============================================================
+    // REPLAY - Load unsettled credits into memory
+    // ============================================================
+    protected void Replay()
+    {
+        if (!FileExist(LEDGER_FILE))
+        {
+            return;
+        }
+
+        FileHandle file = OpenFile(LEDGER_FILE, FileMode.READ);
+        if (!file)
+        {
+            return;
+        }
+
+        JsonSerializer serializer = new JsonSerializer();
+        string line;
+        while (FGets(file, line) >= 0)
+        {
+            if (line == "")
+            {
+                continue;
+            }
+
+            BankingPendingCredit credit = new BankingPendingCredit();
+            string error;
+            if (!serializer.ReadFromString(credit, line, error))
+            {
+                // Torn last line after a crash - skip it
+                ModLogger.Warning(BANKING_LOG, "Skipping corrupt pending credit: " + error);
+                continue;
+            }
+
+            AddPending(credit);
+
+            if (credit.Seq > m_State.LastSeq)
+            {
+                m_State.LastSeq = credit.Seq;
+            }
+        }
+
+        CloseFile(file);
+
+        ModLogger.Info(BANKING_LOG, "Pending credits loaded: " + m_PendingCount.ToString() + " credit(s), " + m_Pending.Count().ToString() + " account(s)");
+    }
+
+    // ============================================================
+    // APPEND - Record a credit for an offline recipient
+    // ============================================================
+    bool Append(string targetID, string senderID, string senderName, int amount)
+    {
+        BankingPendingCredit credit = new BankingPendingCredit();
+        credit.Seq = m_State.LastSeq + 1;
+        credit.TargetID = targetID;
+        credit.SenderID = senderID;
+        credit.SenderName = senderName;
+        credit.Amount = amount;
+        credit.Timestamp = GetGame().GetTickTime();
+
+        string line;
+        JsonSerializer serializer = new JsonSerializer();
+        if (!serializer.WriteToString(credit, false, line))
+        {
+            ModLogger.Error(BANKING_LOG, "Failed to serialize pending credit for " + targetID);
+            return false;
+        }
+
+        FileHandle file = OpenFile(LEDGER_FILE, FileMode.APPEND);
+        if (!file)
+        {
+            ModLogger.Error(BANKING_LOG, "Failed to open pending credit ledger");
+            return false;
+        }
+
+        FPrintln(file, line);
+        CloseFile(file);
+        BankingIOStats.LedgerAppends++;
+
+        m_State.LastSeq = credit.Seq;
+        AddPending(credit);
+
+        return true;
+    }
+
+    // ============================================================
+    // HAS PENDING - Recipient has credits waiting
+    // ============================================================
+    bool HasPending(string targetID)
+    {
+        return m_Pending.Contains(targetID);
+    }
+
+    // ============================================================
+    // GET PENDING - Credits for one recipient, oldest first
+    // ============================================================
+    array<ref BankingPendingCredit> GetPending(string targetID)
+    {
+        return m_Pending.Get(targetID);
+    }
+
+    // ============================================================
+    // SETTLE - Forget credits up to seq once the account is durable
+    // ============================================================
+    void Settle(string targetID, int upToSeq)
+    {
+        array<ref BankingPendingCredit> credits = m_Pending.Get(targetID);
+        if (!credits)
+        {
+            return;
+        }
+
+        int settled = 0;
+        while (settled < credits.Count() && credits[settled].Seq <= upToSeq)
+        {
+            settled++;
+        }
+
+        if (settled == 0)
+        {
+            return;
+        }
+
+        if (settled == credits.Count())
+        {
+            m_Pending.Remove(targetID);
+        }
+        else
+        {
+            for (int i = settled - 1; i >= 0; i--)
+            {
+                credits.RemoveOrdered(i);
+            }
+        }
+
+        m_PendingCount -= settled;
+        m_SettledSinceRewrite += settled;
+
+        if (m_SettledSinceRewrite >= REWRITE_THRESHOLD)
+        {
+            Rewrite();
+        }
+    }
+
+    // ============================================================
+    // REWRITE - Drop settled credits from the log
+    // ============================================================
+    // Writes the unsettled credits to a temp file first; the state
+    // file keeps the sequence counter even if the log ends up empty.
+    void Rewrite()
+    {
+        if (m_SettledSinceRewrite == 0)
+        {
+            return;
+        }
+
+        JsonFileLoader<BankingCreditLedgerState>.JsonSaveFile(STATE_FILE, m_State);
+
+        if (m_PendingCount == 0)
+        {
+            DeleteFile(LEDGER_FILE);
+            m_SettledSinceRewrite = 0;
+            return;
+        }
+
+        FileHandle file = OpenFile(LEDGER_TEMP_FILE, FileMode.WRITE);
+        if (!file)
+        {
+            ModLogger.Error(BANKING_LOG, "Failed to rewrite pending credit ledger");
+            return;
+        }
+
+        JsonSerializer serializer = new JsonSerializer();
+        foreach (string targetID, array<ref BankingPendingCredit> credits : m_Pending)
+        {
+            foreach (BankingPendingCredit credit : credits)
+            {
+                string line;
+                if (serializer.WriteToString(credit, false, line))
+                {
+                    FPrintln(file, line);
+                }
+            }
+        }
+
+        CloseFile(file);
+
+        CopyFile(LEDGER_TEMP_FILE, LEDGER_FILE);
+        DeleteFile(LEDGER_TEMP_FILE);
+
+        m_SettledSinceRewrite = 0;
+    }
+
+    // ============================================================
+    // STATISTICS
+    // ============================================================
+    int GetPendingCount()
+    {
+        return m_PendingCount;
+    }
+
+    int GetPendingAccountCount()
+    {
+        return m_Pending.Count();
+    }
+
+    // ============================================================
+    // HELPERS
+    // ============================================================
+    protected void AddPending(BankingPendingCredit credit)
+    {
+        array<ref BankingPendingCredit> credits = m_Pending.Get(credit.TargetID);
+        if (!credits)
+        {
+            credits = new array<ref BankingPendingCredit>;
+            m_Pending.Set(credit.TargetID, credits);
+        }
+
+        credits.Insert(credit);
+        m_PendingCount++;
+    }
+}
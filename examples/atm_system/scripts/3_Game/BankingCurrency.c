@@ -0,0 +1,480 @@
+// ============================================================
+// BANKING CURRENCY - Inventory census and change-making
+// ============================================================
+// One inventory pass builds a denomination histogram of all
+// currency the player carries. A removal plan is computed from
+// the histogram and applied in one batch, giving change back
+// when the coins carried cannot match the amount exactly.
+
+// ============================================================
+// CURRENCY STACK - One currency item found in inventory
+// ============================================================
+class BankingCurrencyStack
+{
+    ItemBase Item;
+    int UnitValue;      // Value of one unit (one coin)
+    int Units;          // Units in this item (quantity, 1 for non-stackable)
+    int Taken;          // Units reserved by the current removal plan
+
+    void BankingCurrencyStack(ItemBase item, int unitValue, int units)
+    {
+        Item = item;
+        UnitValue = unitValue;
+        Units = units;
+        Taken = 0;
+    }
+}
+
+// ============================================================
+// CURRENCY CENSUS - Denomination histogram of one inventory
+// ============================================================
+class BankingCurrencyCensus
+{
+    protected ref map<int, ref array<ref BankingCurrencyStack>> m_StacksByValue;
+    protected ref array<int> m_Denominations;  // Unit values, largest first
+    protected int m_TotalValue;
+    protected int m_ChangeDue;
+
+    void BankingCurrencyCensus()
+    {
+        m_StacksByValue = new map<int, ref array<ref BankingCurrencyStack>>;
+        m_Denominations = new array<int>;
+        m_TotalValue = 0;
+        m_ChangeDue = 0;
+    }
+
+    // ============================================================
+    // TAKE - Single pass over the player's inventory
+    // ============================================================
+    static BankingCurrencyCensus Take(PlayerBase player)
+    {
+        BankingCurrencyCensus census = new BankingCurrencyCensus();
+        BankingConfig config = GetBankingConfig();
+
+        array<EntityAI> items = new array<EntityAI>;
+        player.GetInventory().EnumerateInventory(InventoryTraversalType.PREORDER, items);
+
+        foreach (EntityAI entity : items)
+        {
+            ItemBase item = ItemBase.Cast(entity);
+            if (!item)
+            {
+                continue;
+            }
+
+            // Precomputed class -> value table (0 = not currency)
+            int unitValue = config.GetCurrencyValue(item.GetType());
+            if (unitValue <= 0)
+            {
+                continue;
+            }
+
+            int units = 1;
+            if (item.HasQuantity())
+            {
+                units = item.GetQuantity();
+            }
+
+            if (units > 0)
+            {
+                census.Add(new BankingCurrencyStack(item, unitValue, units));
+            }
+        }
+
+        census.m_Denominations.Sort(true);  // Largest first
+        return census;
+    }
+
+    protected void Add(BankingCurrencyStack stack)
+    {
+        array<ref BankingCurrencyStack> stacks = m_StacksByValue.Get(stack.UnitValue);
+        if (!stacks)
+        {
+            stacks = new array<ref BankingCurrencyStack>;
+            m_StacksByValue.Set(stack.UnitValue, stacks);
+            m_Denominations.Insert(stack.UnitValue);
+        }
+
+        stacks.Insert(stack);
+        m_TotalValue += stack.UnitValue * stack.Units;
+    }
+
+    // ============================================================
+    // GET TOTAL VALUE - All currency carried
+    // ============================================================
+    int GetTotalValue()
+    {
+        return m_TotalValue;
+    }
+
+    // ============================================================
+    // GET CHANGE DUE - Overpayment of the last plan
+    // ============================================================
+    int GetChangeDue()
+    {
+        return m_ChangeDue;
+    }
+
+    // ============================================================
+    // PLAN REMOVAL - Reserve units covering amount with least change
+    // ============================================================
+    // Candidate A: greedy largest-first without overshooting, then one
+    //              unit of the smallest denomination that covers the rest.
+    // Candidate B: one unit of the smallest denomination >= amount.
+    // The candidate with less change wins (exact for the usual
+    // 10/50/100/1000 denominations). Returns false if not enough currency.
+    bool PlanRemoval(int amount)
+    {
+        ResetPlan();
+
+        if (amount <= 0 || m_TotalValue < amount)
+        {
+            return false;
+        }
+
+        // Candidate A
+        int remaining = amount;
+        foreach (int denomination : m_Denominations)
+        {
+            if (remaining < denomination)
+            {
+                continue;
+            }
+
+            remaining -= ReserveUnits(denomination, remaining / denomination);
+        }
+
+        int topUpValue = 0;
+        if (remaining > 0)
+        {
+            topUpValue = FindSmallestAvailable(remaining);
+            if (topUpValue == 0)
+            {
+                // Only smaller coins are left - round each one up until covered
+                for (int i = 0; i < m_Denominations.Count() && remaining > 0; i++)
+                {
+                    int value = m_Denominations[i];
+                    int needed = (remaining + value - 1) / value;
+                    remaining -= ReserveUnits(value, needed);
+                }
+            }
+            else
+            {
+                ReserveUnits(topUpValue, 1);
+                remaining -= topUpValue;
+            }
+        }
+
+        int changeA = -remaining;
+
+        // Candidate B
+        int singleValue = FindSmallestDenominationAtLeast(amount);
+        if (singleValue > 0 && singleValue - amount < changeA)
+        {
+            ResetPlan();
+            ReserveUnits(singleValue, 1);
+            m_ChangeDue = singleValue - amount;
+            return true;
+        }
+
+        m_ChangeDue = changeA;
+        return true;
+    }
+
+    // ============================================================
+    // APPLY REMOVAL - Remove planned units in one batch
+    // ============================================================
+    // Returns the change that must be given back to the player
+    int ApplyRemoval(PlayerBase player)
+    {
+        foreach (int denomination, array<ref BankingCurrencyStack> stacks : m_StacksByValue)
+        {
+            foreach (BankingCurrencyStack stack : stacks)
+            {
+                if (stack.Taken == 0 || !stack.Item)
+                {
+                    continue;
+                }
+
+                if (stack.Taken >= stack.Units)
+                {
+                    // Whole item
+                    player.GetInventory().RemoveItem(stack.Item);
+                    GetGame().ObjectDelete(stack.Item);
+                }
+                else
+                {
+                    // Part of a stack
+                    stack.Item.AddQuantity(-stack.Taken);
+                }
+
+                stack.Units -= stack.Taken;
+                m_TotalValue -= stack.Taken * stack.UnitValue;
+                stack.Taken = 0;
+            }
+        }
+
+        int change = m_ChangeDue;
+        m_ChangeDue = 0;
+        return change;
+    }
+
+    // ============================================================
+    // HELPERS
+    // ============================================================
+    // Reserves up to count units of one denomination; returns the value reserved
+    protected int ReserveUnits(int denomination, int count)
+    {
+        array<ref BankingCurrencyStack> stacks = m_StacksByValue.Get(denomination);
+        int reserved = 0;
+
+        foreach (BankingCurrencyStack stack : stacks)
+        {
+            if (reserved >= count)
+            {
+                break;
+            }
+
+            int take = Math.Min(stack.Units - stack.Taken, count - reserved);
+            stack.Taken += take;
+            reserved += take;
+        }
+
+        return reserved * denomination;
+    }
+
+    protected int AvailableUnits(int denomination)
+    {
+        int available = 0;
+        array<ref BankingCurrencyStack> stacks = m_StacksByValue.Get(denomination);
+
+        foreach (BankingCurrencyStack stack : stacks)
+        {
+            available += stack.Units - stack.Taken;
+        }
+
+        return available;
+    }
+
+    // Smallest denomination >= value with an unreserved unit (0 = none)
+    protected int FindSmallestAvailable(int value)
+    {
+        for (int i = m_Denominations.Count() - 1; i >= 0; i--)
+        {
+            int denomination = m_Denominations[i];
+            if (denomination >= value && AvailableUnits(denomination) > 0)
+            {
+                return denomination;
+            }
+        }
+
+        return 0;
+    }
+
+    // Smallest denomination >= value carried at all (0 = none)
+    protected int FindSmallestDenominationAtLeast(int value)
+    {
+        for (int i = m_Denominations.Count() - 1; i >= 0; i--)
+        {
+            if (m_Denominations[i] >= value)
+            {
+                return m_Denominations[i];
+            }
+        }
+
+        return 0;
+    }
+
+    protected void ResetPlan()
+    {
+        foreach (int denomination, array<ref BankingCurrencyStack> stacks : m_StacksByValue)
+        {
+            foreach (BankingCurrencyStack stack : stacks)
+            {
+                stack.Taken = 0;
+            }
+        }
+
+        m_ChangeDue = 0;
+    }
+}
+
+// ============================================================
+// CURRENCY SPAWNER - Stack-aware currency creation for withdrawals
+// ============================================================
+// Builds a plan of quantity-bearing stacks (each up to the item's
+// varQuantityMax), places them into free inventory slots, and puts
+// whatever does not fit into a single container on the ground.
+
+class BankingCurrencySpawnStack
+{
+    string ClassName;
+    int Units;
+
+    void BankingCurrencySpawnStack(string className, int units)
+    {
+        ClassName = className;
+        Units = units;
+    }
+}
+
+class BankingCurrencySpawner
+{
+    // Class name -> max units per stack (read from config once)
+    protected static ref map<string, int> s_MaxStackUnits;
+
+    // ============================================================
+    // SPAWN - Create currency worth up to amount for player
+    // ============================================================
+    // Returns the part that was not paid (see GetUnpayable)
+    static int Spawn(PlayerBase player, int amount)
+    {
+        array<ref BankingCurrencySpawnStack> plan = new array<ref BankingCurrencySpawnStack>;
+        int unpaid = BuildPlan(amount, plan);
+
+        EntityAI overflowContainer;
+        bool inventoryFull = false;
+
+        foreach (BankingCurrencySpawnStack stack : plan)
+        {
+            ItemBase item;
+
+            // Stop probing the inventory after the first miss
+            if (!inventoryFull)
+            {
+                item = CreateInPlayerInventory(player, stack.ClassName);
+                if (!item)
+                {
+                    inventoryFull = true;
+                }
+            }
+
+            if (!item)
+            {
+                if (!overflowContainer)
+                {
+                    overflowContainer = EntityAI.Cast(GetGame().CreateObjectEx(GetBankingConfig().OverflowContainerClass, player.GetPosition(), ECE_PLACE_ON_SURFACE));
+                }
+
+                if (overflowContainer)
+                {
+                    item = ItemBase.Cast(overflowContainer.GetInventory().CreateInInventory(stack.ClassName));
+                }
+
+                if (!item)
+                {
+                    // Container missing or full - last resort, loose on the ground
+                    item = ItemBase.Cast(GetGame().CreateObjectEx(stack.ClassName, player.GetPosition(), ECE_PLACE_ON_SURFACE));
+                }
+            }
+
+            if (item && item.HasQuantity())
+            {
+                item.SetQuantity(stack.Units);
+            }
+        }
+
+        if (overflowContainer)
+        {
+            NotificationSystem.Notify(player, "Inventory full! Remaining currency was placed in a container at your feet.");
+        }
+
+        return unpaid;
+    }
+
+    // ============================================================
+    // GET UNPAYABLE - Part of amount no WithdrawCurrencies coin can pay
+    // ============================================================
+    // Spawn never rounds up, so this much is not paid out; callers
+    // keep it in the balance (e.g. change below the smallest coin).
+    static int GetUnpayable(int amount)
+    {
+        BankingConfig config = GetBankingConfig();
+        int remaining = amount;
+
+        foreach (string className : config.WithdrawCurrencies)
+        {
+            int value = config.GetCurrencyValue(className);
+            if (value > 0)
+            {
+                remaining = remaining % value;
+            }
+        }
+
+        return remaining;
+    }
+
+    // ============================================================
+    // BUILD PLAN - Split amount into stacks, largest denomination first
+    // ============================================================
+    // Returns the remainder below the smallest denomination (not planned)
+    static int BuildPlan(int amount, array<ref BankingCurrencySpawnStack> plan)
+    {
+        BankingConfig config = GetBankingConfig();
+        int remaining = amount;
+
+        foreach (string className : config.WithdrawCurrencies)
+        {
+            int value = config.GetCurrencyValue(className);
+            if (value <= 0)
+            {
+                continue;
+            }
+
+            int units = remaining / value;
+            if (units <= 0)
+            {
+                continue;
+            }
+
+            remaining -= units * value;
+
+            int maxUnits = GetMaxStackUnits(className);
+            while (units > 0)
+            {
+                int stackUnits = Math.Min(units, maxUnits);
+                plan.Insert(new BankingCurrencySpawnStack(className, stackUnits));
+                units -= stackUnits;
+            }
+        }
+
+        return remaining;
+    }
+
+    // ============================================================
+    // HELPERS
+    // ============================================================
+    protected static ItemBase CreateInPlayerInventory(PlayerBase player, string className)
+    {
+        InventoryLocation location = new InventoryLocation();
+        if (!player.GetInventory().FindFirstFreeLocationForNewEntity(className, FindInventoryLocationType.ANY, location))
+        {
+            return null;
+        }
+
+        return ItemBase.Cast(GameInventory.LocationCreateEntity(location, className, ECE_IN_INVENTORY, RF_DEFAULT));
+    }
+
+    static int GetMaxStackUnits(string className)
+    {
+        if (!s_MaxStackUnits)
+        {
+            s_MaxStackUnits = new map<string, int>;
+        }
+
+        if (s_MaxStackUnits.Contains(className))
+        {
+            return s_MaxStackUnits.Get(className);
+        }
+
+        // Non-stackable items have no varQuantityMax
+        int maxUnits = GetGame().ConfigGetInt("CfgVehicles " + className + " varQuantityMax");
+        if (maxUnits < 1)
+        {
+            maxUnits = 1;
+        }
+
+        s_MaxStackUnits.Set(className, maxUnits);
+        return maxUnits;
+    }
+}
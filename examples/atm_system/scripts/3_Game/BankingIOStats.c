@@ -0,0 +1,29 @@
+// ============================================================
+// BANKING IO STATS - File operation counters
+// ============================================================
+// Incremented by the persistence code, read by BankingBenchmark
+// and admin tools to see how much disk work each strategy costs.
+
+class BankingIOStats
+{
+    static int AccountReads;        // Account snapshots read (store Load)
+    static int AccountWrites;       // Account snapshots written (store Save)
+    static int JournalAppends;      // Journal records appended
+    static int LedgerAppends;       // Pending credits appended
+    static int BackupWrites;        // Backup files written
+
+    // All file writes, whatever the kind
+    static int GetTotalWrites()
+    {
+        return AccountWrites + JournalAppends + LedgerAppends + BackupWrites;
+    }
+
+    static void Reset()
+    {
+        AccountReads = 0;
+        AccountWrites = 0;
+        JournalAppends = 0;
+        LedgerAppends = 0;
+        BackupWrites = 0;
+    }
+}
@@ -0,0 +1,387 @@
+// ============================================================
+// BANKING JOURNAL - Append-only transaction log
+// ============================================================
+// Durable store for account changes between snapshots.
+// Every transaction appends one line (JSON record) instead of
+// rewriting the whole account file.
+//
+// Files in $profile:Banking/:
+//   journal_<generation>.log  - Append-only records (one JSON per line)
+//   journal_state.json        - Which generations are still live
+//
+// Account snapshots are written by BankingAccount.Save through
+// BankingAccountStore: Accounts/<shard>/<SteamID64>.bin (binary store,
+// shard = hash of the ID) or <SteamID64>.json ("json" store).
+//
+// Recovery: snapshot + replay of records with Seq > snapshot.JournalSeq.
+// Compaction: rotate to a new generation, snapshot every account that
+// has pending records, then delete the old generation files.
+
+// ============================================================
+// JOURNAL RECORD - Account state after one transaction
+// ============================================================
+// Stores the resulting state (not a delta), so replaying a record
+// twice is harmless.
+class BankingJournalRecord
+{
+    int Seq;                              // Server-wide sequence number
+    string PlayerID;                      // Account owner (Steam64 ID)
+    string PlayerName;                    // Account owner name
+    int Balance;                          // Balance after transaction
+    int DailyWithdrawn;                   // Daily withdrawal counter after transaction
+    int LastWithdrawReset;                // Daily reset timestamp after transaction
+    int LastCreditSeq;                    // Last pending credit folded in
+    int MaxBalance;                       // Balance limit after transaction (0 = not recorded)
+    int LastBulkOperation;                // Last bulk operation applied
+    ref BankingTransactionBatch TransactionData;  // Encoded transaction to add to history (optional)
+}
+
+// ============================================================
+// JOURNAL STATE - Live generation range
+// ============================================================
+class BankingJournalState
+{
+    int FirstGeneration;    // Oldest generation not yet compacted
+    int CurrentGeneration;  // Generation receiving new appends
+
+    void BankingJournalState()
+    {
+        FirstGeneration = 0;
+        CurrentGeneration = 0;
+    }
+}
+
+class BankingJournal
+{
+    static const string JOURNAL_DIR = "$profile:Banking/";
+    static const string STATE_FILE = "$profile:Banking/journal_state.json";
+
+    protected ref BankingJournalState m_State;
+    protected int m_LastSeq;
+
+    // Records not yet covered by a snapshot, per account
+    protected ref map<string, ref array<ref BankingJournalRecord>> m_Pending;
+
+    // Compaction in progress
+    protected bool m_IsCompacting;
+    protected int m_CompactUpToGeneration;
+    protected ref array<string> m_CompactQueue;
+
+    // ============================================================
+    // CONSTRUCTOR - Replay existing journal files
+    // ============================================================
+    void BankingJournal()
+    {
+        m_State = new BankingJournalState();
+        m_Pending = new map<string, ref array<ref BankingJournalRecord>>;
+        m_CompactQueue = new array<string>;
+        m_IsCompacting = false;
+        m_LastSeq = 0;
+
+        if (!FileExist(JOURNAL_DIR))
+        {
+            MakeDirectory(JOURNAL_DIR);
+        }
+
+        if (FileExist(STATE_FILE))
+        {
+            JsonFileLoader<BankingJournalState>.JsonLoadFile(STATE_FILE, m_State);
+        }
+
+        Replay();
+    }
+
+    // ============================================================
+    // GET JOURNAL FILE - Path of one generation
+    // ============================================================
+    static string GetJournalFile(int generation)
+    {
+        return JOURNAL_DIR + "journal_" + generation.ToString() + ".log";
+    }
+
+    // ============================================================
+    // REPLAY - Read all live generations into the pending index
+    // ============================================================
+    protected void Replay()
+    {
+        int recordCount = 0;
+        bool currentCorrupt = false;
+        JsonSerializer serializer = new JsonSerializer();
+
+        for (int generation = m_State.FirstGeneration; generation <= m_State.CurrentGeneration; generation++)
+        {
+            string filePath = GetJournalFile(generation);
+            if (!FileExist(filePath))
+            {
+                continue;
+            }
+
+            FileHandle file = OpenFile(filePath, FileMode.READ);
+            if (!file)
+            {
+                continue;
+            }
+
+            string line;
+            while (FGets(file, line) >= 0)
+            {
+                if (line == "")
+                {
+                    continue;
+                }
+
+                BankingJournalRecord record = new BankingJournalRecord();
+                string error;
+                if (!serializer.ReadFromString(record, line, error))
+                {
+                    // Torn last line after a crash - skip it
+                    ModLogger.Warning(BANKING_LOG, "Skipping corrupt journal record: " + error);
+                    currentCorrupt = generation == m_State.CurrentGeneration;
+                    continue;
+                }
+
+                AddPending(record);
+                recordCount++;
+
+                if (record.Seq > m_LastSeq)
+                {
+                    m_LastSeq = record.Seq;
+                }
+            }
+
+            CloseFile(file);
+        }
+
+        // The next append would be glued onto the torn line - start a
+        // new generation; the old one stays live until compaction
+        if (currentCorrupt)
+        {
+            m_State.CurrentGeneration++;
+            SaveState();
+        }
+
+        ModLogger.Info(BANKING_LOG, "Journal replayed: " + recordCount.ToString() + " record(s), " + m_Pending.Count().ToString() + " account(s)");
+    }
+
+    // ============================================================
+    // APPEND - Write account state after a transaction
+    // ============================================================
+    bool Append(BankingAccount account, BankingTransaction transaction = null)
+    {
+        BankingJournalRecord record = new BankingJournalRecord();
+        record.Seq = ++m_LastSeq;
+        record.PlayerID = account.SteamID64;
+        record.PlayerName = account.PlayerName;
+        record.Balance = account.Balance;
+        record.DailyWithdrawn = account.DailyWithdrawn;
+        record.LastWithdrawReset = account.LastWithdrawReset;
+        record.LastCreditSeq = account.LastCreditSeq;
+        record.MaxBalance = account.MaxBalance;
+        record.LastBulkOperation = account.LastBulkOperation;
+
+        if (transaction)
+        {
+            array<ref BankingTransaction> single = new array<ref BankingTransaction>;
+            single.Insert(transaction);
+            record.TransactionData = BankingTransactionCodec.Encode(single);
+        }
+
+        string line;
+        JsonSerializer serializer = new JsonSerializer();
+        if (!serializer.WriteToString(record, false, line))
+        {
+            ModLogger.Error(BANKING_LOG, "Failed to serialize journal record for " + account.SteamID64);
+            return false;
+        }
+
+        FileHandle file = OpenFile(GetJournalFile(m_State.CurrentGeneration), FileMode.APPEND);
+        if (!file)
+        {
+            ModLogger.Error(BANKING_LOG, "Failed to open journal file");
+            return false;
+        }
+
+        FPrintln(file, line);
+        CloseFile(file);
+        BankingIOStats.JournalAppends++;
+
+        account.JournalSeq = record.Seq;
+        AddPending(record);
+
+        return true;
+    }
+
+    // ============================================================
+    // APPLY PENDING - Bring a loaded snapshot up to date
+    // ============================================================
+    void ApplyPending(BankingAccount account)
+    {
+        array<ref BankingJournalRecord> records = m_Pending.Get(account.SteamID64);
+        if (!records)
+        {
+            return;
+        }
+
+        foreach (BankingJournalRecord record : records)
+        {
+            if (record.Seq <= account.JournalSeq)
+            {
+                continue;  // Already in snapshot
+            }
+
+            account.PlayerName = record.PlayerName;
+            account.Balance = record.Balance;
+            account.DailyWithdrawn = record.DailyWithdrawn;
+            account.LastWithdrawReset = record.LastWithdrawReset;
+            account.LastCreditSeq = record.LastCreditSeq;
+            account.LastBulkOperation = Math.Max(account.LastBulkOperation, record.LastBulkOperation);
+            account.JournalSeq = record.Seq;
+
+            if (record.MaxBalance > 0)
+            {
+                account.MaxBalance = record.MaxBalance;
+            }
+
+            if (record.TransactionData)
+            {
+                array<ref BankingTransaction> decoded = new array<ref BankingTransaction>;
+                BankingTransactionCodec.Decode(record.TransactionData, decoded);
+
+                foreach (BankingTransaction transaction : decoded)
+                {
+                    account.AddTransactionToHistory(transaction);
+                }
+            }
+        }
+    }
+
+    // ============================================================
+    // HAS PENDING - Account has records newer than its snapshot
+    // ============================================================
+    bool HasPending(string playerID)
+    {
+        return m_Pending.Contains(playerID);
+    }
+
+    // ============================================================
+    // ON SNAPSHOT WRITTEN - Drop records covered by the snapshot
+    // ============================================================
+    void OnSnapshotWritten(BankingAccount account)
+    {
+        array<ref BankingJournalRecord> records = m_Pending.Get(account.SteamID64);
+        if (!records)
+        {
+            return;
+        }
+
+        for (int i = records.Count() - 1; i >= 0; i--)
+        {
+            if (records[i].Seq <= account.JournalSeq)
+            {
+                records.RemoveOrdered(i);
+            }
+        }
+
+        if (records.Count() == 0)
+        {
+            m_Pending.Remove(account.SteamID64);
+        }
+    }
+
+    // ============================================================
+    // BEGIN COMPACTION - Rotate generation and queue accounts
+    // ============================================================
+    // Returns false if there is nothing to compact or compaction is running
+    bool BeginCompaction()
+    {
+        if (m_IsCompacting || m_Pending.Count() == 0)
+        {
+            return false;
+        }
+
+        // New appends go to a fresh generation from now on
+        m_CompactUpToGeneration = m_State.CurrentGeneration;
+        m_State.CurrentGeneration++;
+        SaveState();
+
+        m_CompactQueue.Clear();
+        foreach (string playerID, array<ref BankingJournalRecord> records : m_Pending)
+        {
+            m_CompactQueue.Insert(playerID);
+        }
+
+        m_IsCompacting = true;
+
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.INFO))
+        {
+            ModLogger.Info(BANKING_LOG, "Journal compaction started: " + m_CompactQueue.Count().ToString() + " account(s)");
+        }
+
+        return true;
+    }
+
+    // ============================================================
+    // GET COMPACT QUEUE - Accounts still waiting for a snapshot
+    // ============================================================
+    array<string> GetCompactQueue()
+    {
+        return m_CompactQueue;
+    }
+
+    bool IsCompacting()
+    {
+        return m_IsCompacting;
+    }
+
+    // ============================================================
+    // FINISH COMPACTION - Delete compacted generations
+    // ============================================================
+    // Call once every account in the compact queue has a fresh snapshot
+    void FinishCompaction()
+    {
+        if (!m_IsCompacting)
+        {
+            return;
+        }
+
+        for (int generation = m_State.FirstGeneration; generation <= m_CompactUpToGeneration; generation++)
+        {
+            string filePath = GetJournalFile(generation);
+            if (FileExist(filePath))
+            {
+                DeleteFile(filePath);
+            }
+        }
+
+        m_State.FirstGeneration = m_CompactUpToGeneration + 1;
+        SaveState();
+
+        m_CompactQueue.Clear();
+        m_IsCompacting = false;
+
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.INFO))
+        {
+            ModLogger.Info(BANKING_LOG, "Journal compaction finished. Live generation: " + m_State.CurrentGeneration.ToString());
+        }
+    }
+
+    // ============================================================
+    // HELPERS
+    // ============================================================
+    protected void AddPending(BankingJournalRecord record)
+    {
+        array<ref BankingJournalRecord> records = m_Pending.Get(record.PlayerID);
+        if (!records)
+        {
+            records = new array<ref BankingJournalRecord>;
+            m_Pending.Set(record.PlayerID, records);
+        }
+
+        records.Insert(record);
+    }
+
+    protected void SaveState()
+    {
+        JsonFileLoader<BankingJournalState>.JsonSaveFile(STATE_FILE, m_State);
+    }
+}
@@ -7,17 +7,38 @@
 // - Transfer money
 // - Transaction queue management
 // - Player account management
+// - Write-behind persistence (dirty accounts flushed in batches)
+// - Journal persistence (append-only log + snapshot compaction)
+// - Money supply metrics (BankingMetrics)
 
 class BankingManager
 {
     // Singleton instance
     private static ref BankingManager m_Instance;
 
-    // Transaction queue (FIFO)
-    private ref array<ref BankingTransaction> m_TransactionQueue;
+    // Transaction queue (FIFO ring buffer)
+    private ref BankingTransactionQueue m_TransactionQueue;
 
-    // Active player accounts (cached)
-    private ref map<string, ref BankingAccount> m_AccountCache;
+    // Active player accounts (LRU cache, online players pinned)
+    private ref BankingAccountCache m_AccountCache;
+    private bool m_EvictionScheduled;
+    private int m_ConfigGeneration;     // Config snapshot the cache capacity came from
+
+    // What each online client last received (delta sync)
+    private ref map<string, ref BankingSyncState> m_SyncStates;
+
+    // Accounts changed in memory and waiting to be written (FIFO, no duplicates)
+    private ref array<string> m_DirtyAccounts;
+
+    // Append-only journal (null when JournalEnabled is false)
+    private ref BankingJournal m_Journal;
+    private int m_LastCompactionTime;
+
+    // Credits for transfers to players whose account is not loaded
+    private ref BankingCreditLedger m_CreditLedger;
+
+    // Running totals, richest accounts and daily volume
+    private ref BankingMetrics m_Metrics;
 
     // ============================================================
     // GET INSTANCE - Singleton pattern
@@ -37,13 +58,37 @@ class BankingManager
     // ============================================================
     void BankingManager()
     {
-        m_TransactionQueue = new array<ref BankingTransaction>;
-        m_AccountCache = new map<string, ref BankingAccount>;
+        m_TransactionQueue = new BankingTransactionQueue(GetBankingConfig().TransactionQueueSize);
+        m_AccountCache = new BankingAccountCache(GetBankingConfig().AccountCacheCapacity);
+        m_EvictionScheduled = false;
+        m_ConfigGeneration = GetBankingConfig().GetGeneration();
+        m_SyncStates = new map<string, ref BankingSyncState>;
+        m_DirtyAccounts = new array<string>;
+        m_CreditLedger = new BankingCreditLedger();
 
         // Start transaction queue processor
-        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(ProcessTransactionQueue, 1000, true);
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(ProcessTransactionQueue, GetBankingConfig().TransactionQueueIntervalMs, true);
+
+        // Start write-behind flusher
+        if (GetBankingConfig().WriteBehindEnabled)
+        {
+            GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(FlushDirtyAccounts, GetBankingConfig().FlushIntervalMs, true);
+        }
+
+        // Replay journal and start compaction ticker
+        if (GetBankingConfig().JournalEnabled)
+        {
+            m_Journal = new BankingJournal();
+            m_LastCompactionTime = GetGame().GetTime();
+            GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(CompactJournalStep, 1000, true);
+        }
+
+        m_Metrics = new BankingMetrics();
 
-        Print("[ATM System] BankingManager initialized.");
+        // Continue a bulk operation interrupted by a restart
+        BankingBulkOperation.GetInstance().Resume();
+
+        ModLogger.Info(BANKING_LOG, "BankingManager initialized.");
     }
 
     // ============================================================
@@ -52,32 +97,482 @@ class BankingManager
     BankingAccount GetPlayerAccount(string playerID, string playerName = "")
     {
         // Check cache first
-        if (m_AccountCache.Contains(playerID))
+        BankingAccount cached = m_AccountCache.Get(playerID);
+        if (cached)
         {
-            return m_AccountCache.Get(playerID);
+            return cached;
         }
 
         // Load from file
         BankingAccount account = BankingAccount.Load(playerID, playerName);
 
+        // Replay journal records newer than the snapshot
+        if (m_Journal)
+        {
+            m_Journal.ApplyPending(account);
+        }
+
         // Add to cache
-        m_AccountCache.Set(playerID, account);
+        m_AccountCache.Put(playerID, account);
+        ScheduleEviction();
+
+        // Before credits - they are counted as changes from this balance
+        m_Metrics.OnAccountLoaded(account);
+
+        // Fold in transfers received while the account was not loaded
+        if (m_CreditLedger.HasPending(playerID))
+        {
+            ApplyPendingCredits(account);
+        }
 
         return account;
     }
 
     // ============================================================
-    // SAVE PLAYER ACCOUNT - Save to file and update cache
+    // READ ACCOUNT - Current state without loading it
     // ============================================================
-    void SavePlayerAccount(string playerID)
+    // The cached account if there is one, otherwise a fresh copy from
+    // the store with journal records applied. Nothing is cached,
+    // migrated or written, and cache stats are not touched. Ledger
+    // credits are not included. Null if the account does not exist.
+    BankingAccount ReadAccount(string playerID)
     {
-        if (m_AccountCache.Contains(playerID))
+        BankingAccount cached = m_AccountCache.Peek(playerID);
+        if (cached)
+        {
+            return cached;
+        }
+
+        BankingAccount account = new BankingAccount();
+        if (!BankingAccountStore.GetInstance().Read(playerID, account))
+        {
+            return null;
+        }
+
+        BankingIOStats.AccountReads++;
+
+        if (m_Journal)
+        {
+            m_Journal.ApplyPending(account);
+        }
+
+        return account;
+    }
+
+    // ============================================================
+    // WRITE ACCOUNT - Save a changed account that is not cached
+    // ============================================================
+    // For accounts from ReadAccount that are not in the cache; cached
+    // accounts go through SavePlayerAccount. Writes the snapshot
+    // right away (covers its journal records).
+    void WriteAccount(BankingAccount account, int oldBalance)
+    {
+        m_Metrics.OnBalanceChanged(account.SteamID64, account.PlayerName, oldBalance, account.Balance);
+        WriteSnapshot(account);
+    }
+
+    // ============================================================
+    // CREDIT TRANSFER - Receiving side of a transfer
+    // ============================================================
+    // Online or already loaded targets are credited directly and
+    // written immediately; anyone else gets a ledger entry that is
+    // applied on their next load. A loaded target without room below
+    // MaxBalance gets a ledger entry as well, so the money is never
+    // lost. Returns the target account, or null if the credit went
+    // to the ledger.
+    BankingAccount CreditTransfer(BankingTransaction transaction, string targetID, PlayerBase targetPlayer = null)
+    {
+        BankingAccount targetAccount = m_AccountCache.Peek(targetID);
+        if (!targetAccount && targetPlayer)
+        {
+            targetAccount = GetPlayerAccount(targetID, targetPlayer.GetIdentity().GetName());
+        }
+
+        if (!targetAccount || !targetAccount.Deposit(transaction.Amount))
+        {
+            m_CreditLedger.Append(targetID, transaction.PlayerID, transaction.PlayerName, transaction.Amount);
+            transaction.SetTarget(targetID, targetID);
+            return null;
+        }
+
+        transaction.SetTarget(targetID, targetAccount.PlayerName);
+
+        SavePlayerAccount(targetID);
+        FlushAccount(targetID);
+
+        return targetAccount;
+    }
+
+    // ============================================================
+    // APPLY PENDING CREDITS - Fold ledger credits into the balance
+    // ============================================================
+    // Credits that would exceed MaxBalance stay in the ledger and are
+    // retried on the next load. The account is made durable before
+    // the ledger forgets the credits.
+    protected void ApplyPendingCredits(BankingAccount account)
+    {
+        string playerID = account.SteamID64;
+        array<ref BankingPendingCredit> credits = m_CreditLedger.GetPending(playerID);
+        int applied = 0;
+        int total = 0;
+
+        foreach (BankingPendingCredit credit : credits)
+        {
+            if (credit.Seq <= account.LastCreditSeq)
+            {
+                continue;  // Already folded in before a restart
+            }
+
+            if (!account.Deposit(credit.Amount))
+            {
+                break;  // Keep order - later credits wait as well
+            }
+
+            account.LastCreditSeq = credit.Seq;
+
+            BankingTransaction transaction = new BankingTransaction(playerID, account.PlayerName, credit.Amount, BankingTransactionType.CREDIT);
+            transaction.SetTarget(credit.SenderID, credit.SenderName);
+            transaction.MarkCompleted();
+            account.AddTransactionToHistory(transaction);
+
+            SavePlayerAccount(playerID, transaction);
+            applied++;
+            total += credit.Amount;
+        }
+
+        FlushAccount(playerID);
+        m_CreditLedger.Settle(playerID, account.LastCreditSeq);
+
+#ifdef DEVELOPER
+        if (applied > 0 && ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug(BANKING_LOG, "Applied " + applied.ToString() + " pending credit(s) to " + playerID + ": " + total.ToString());
+        }
+#endif
+    }
+
+    // ============================================================
+    // SAVE PLAYER ACCOUNT - Persist account after a change
+    // ============================================================
+    // Journal mode:      append one record (durable immediately)
+    // Write-behind mode: mark dirty, flusher writes later
+    // Otherwise:         save the account file now
+    void SavePlayerAccount(string playerID, BankingTransaction transaction = null)
+    {
+        m_Metrics.OnAccountChanged(m_AccountCache.Peek(playerID));
+        m_Metrics.OnTransaction(transaction);
+
+        if (m_Journal)
+        {
+            BankingAccount journaled = m_AccountCache.Peek(playerID);
+            if (journaled)
+            {
+                m_Journal.Append(journaled, transaction);
+            }
+            return;
+        }
+
+        if (GetBankingConfig().WriteBehindEnabled)
+        {
+            MarkAccountDirty(playerID);
+            return;
+        }
+
+        BankingAccount account = m_AccountCache.Peek(playerID);
+        if (account)
         {
-            BankingAccount account = m_AccountCache.Get(playerID);
             account.Save();
         }
     }
 
+    // ============================================================
+    // MARK ACCOUNT DIRTY - Schedule account for the next flush
+    // ============================================================
+    void MarkAccountDirty(string playerID)
+    {
+        BankingAccount account = m_AccountCache.Peek(playerID);
+        if (!account)
+        {
+            return;
+        }
+
+        // Already queued - several transactions coalesce into one write
+        if (account.IsDirty())
+        {
+            return;
+        }
+
+        account.MarkDirty();
+        m_DirtyAccounts.Insert(playerID);
+    }
+
+    // ============================================================
+    // FLUSH ACCOUNT - Write one account to disk immediately
+    // ============================================================
+    // Use for operations that need durability (e.g. transfers)
+    void FlushAccount(string playerID)
+    {
+        // Journal records are already on disk
+        if (m_Journal)
+        {
+            return;
+        }
+
+        BankingAccount account = m_AccountCache.Peek(playerID);
+        if (!account)
+        {
+            return;
+        }
+
+        account.Save();
+
+        // Entry stays in m_DirtyAccounts; the flusher skips clean accounts
+    }
+
+    // ============================================================
+    // FLUSH DIRTY ACCOUNTS - Budgeted write-behind flusher
+    // ============================================================
+    // Writes at most FlushMaxAccountsPerTick accounts and stops early
+    // once FlushTimeBudgetMs is spent. Remaining accounts wait for the next run.
+    void FlushDirtyAccounts()
+    {
+        int count = m_DirtyAccounts.Count();
+        if (count == 0)
+        {
+            return;
+        }
+
+        int maxAccounts = GetBankingConfig().FlushMaxAccountsPerTick;
+        int budgetMs = GetBankingConfig().FlushTimeBudgetMs;
+        int startTicks = TickCount(0);
+        int written = 0;
+        int processed = 0;
+
+        while (processed < count)
+        {
+            string playerID = m_DirtyAccounts[processed];
+            processed++;
+
+            BankingAccount account = m_AccountCache.Peek(playerID);
+            if (!account || !account.IsDirty())
+            {
+                continue;  // Already flushed or evicted
+            }
+
+            account.Save();
+            written++;
+
+            if (written >= maxAccounts)
+            {
+                break;
+            }
+
+            // TickCount is in 1/10000 ms units
+            if (TickCount(startTicks) / 10000 >= budgetMs)
+            {
+                break;
+            }
+        }
+
+        // Drop the processed prefix
+        if (processed >= count)
+        {
+            m_DirtyAccounts.Clear();
+        }
+        else
+        {
+            array<string> remaining = new array<string>;
+            for (int i = processed; i < count; i++)
+            {
+                remaining.Insert(m_DirtyAccounts[i]);
+            }
+            m_DirtyAccounts = remaining;
+        }
+
+#ifdef DEVELOPER
+        if (written > 0 && ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug(BANKING_LOG, "Flushed " + written.ToString() + " account(s), " + m_DirtyAccounts.Count().ToString() + " pending");
+        }
+#endif
+    }
+
+    // ============================================================
+    // FLUSH ALL DIRTY ACCOUNTS - Write everything pending (shutdown)
+    // ============================================================
+    void FlushAllDirtyAccounts()
+    {
+        foreach (string playerID : m_DirtyAccounts)
+        {
+            BankingAccount account = m_AccountCache.Peek(playerID);
+            if (account && account.IsDirty())
+            {
+                account.Save();
+            }
+        }
+
+        m_DirtyAccounts.Clear();
+        m_CreditLedger.Rewrite();
+
+        // Every counted change is on disk now
+        m_Metrics.SaveClean();
+    }
+
+    // ============================================================
+    // WRITE SNAPSHOT - Save account file and trim covered journal records
+    // ============================================================
+    private void WriteSnapshot(BankingAccount account)
+    {
+        account.Save();
+
+        if (m_Journal)
+        {
+            m_Journal.OnSnapshotWritten(account);
+        }
+    }
+
+    // ============================================================
+    // COMPACT JOURNAL STEP - Background snapshot compaction
+    // ============================================================
+    // Starts a compaction every JournalCompactIntervalMs, then writes at most
+    // JournalCompactAccountsPerTick snapshots per call until done.
+    private void CompactJournalStep()
+    {
+        if (!m_Journal.IsCompacting())
+        {
+            if (GetGame().GetTime() - m_LastCompactionTime < GetBankingConfig().JournalCompactIntervalMs)
+            {
+                return;
+            }
+
+            m_LastCompactionTime = GetGame().GetTime();
+
+            if (!m_Journal.BeginCompaction())
+            {
+                return;  // Nothing to compact
+            }
+        }
+
+        array<string> queue = m_Journal.GetCompactQueue();
+        int budget = GetBankingConfig().JournalCompactAccountsPerTick;
+
+        while (queue.Count() > 0 && budget > 0)
+        {
+            int last = queue.Count() - 1;
+            string playerID = queue[last];
+            queue.Remove(last);
+
+            BankingAccount account = m_AccountCache.Peek(playerID);
+            if (!account)
+            {
+                // Offline account - rebuild from snapshot + journal without caching it
+                account = BankingAccount.Load(playerID);
+                m_Journal.ApplyPending(account);
+            }
+
+            WriteSnapshot(account);
+            budget--;
+        }
+
+        if (queue.Count() == 0)
+        {
+            m_Journal.FinishCompaction();
+        }
+    }
+
+    // ============================================================
+    // PLAYER CONNECTED / DISCONNECTED - Pin accounts of online players
+    // ============================================================
+    void OnPlayerConnected(string playerID)
+    {
+        m_AccountCache.Pin(playerID);
+    }
+
+    void OnPlayerDisconnected(string playerID)
+    {
+        m_AccountCache.Unpin(playerID);
+        m_SyncStates.Remove(playerID);
+        BankingRequestThrottle.GetInstance().Forget(playerID);
+        ScheduleEviction();
+    }
+
+    // ============================================================
+    // SCHEDULE EVICTION - Evict on the next frame
+    // ============================================================
+    // Deferred so an account is never evicted in the middle of
+    // an operation that loaded a second account (e.g. transfers)
+    private void ScheduleEviction()
+    {
+        if (m_EvictionScheduled || m_AccountCache.Count() <= m_AccountCache.GetCapacity())
+        {
+            return;
+        }
+
+        m_EvictionScheduled = true;
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).Call(EvictColdAccounts);
+    }
+
+    // ============================================================
+    // EVICT COLD ACCOUNTS - Flush and drop LRU accounts above capacity
+    // ============================================================
+    void EvictColdAccounts()
+    {
+        m_EvictionScheduled = false;
+
+        // Pick up a changed capacity after a config reload
+        BankingConfig config = GetBankingConfig();
+        if (config.GetGeneration() != m_ConfigGeneration)
+        {
+            m_AccountCache.SetCapacity(config.AccountCacheCapacity);
+            m_ConfigGeneration = config.GetGeneration();
+        }
+
+        array<ref BankingAccount> evicted = new array<ref BankingAccount>;
+        m_AccountCache.EvictOverflow(evicted);
+
+        foreach (BankingAccount account : evicted)
+        {
+            // Journal records stay pending and are replayed on next load
+            if (account.IsDirty())
+            {
+                WriteSnapshot(account);
+            }
+
+            BankingBackupManager.GetInstance().Forget(account.SteamID64);
+            m_Metrics.Forget(account.SteamID64);
+        }
+
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.INFO) && evicted.Count() > 0)
+        {
+            ModLogger.Info(BANKING_LOG, "Evicted " + evicted.Count().ToString() + " account(s) from cache");
+        }
+    }
+
+    // ============================================================
+    // GET CACHE STATS - Hit/miss/eviction counters
+    // ============================================================
+    string GetCacheStats()
+    {
+        string stats = "Accounts: " + m_AccountCache.Count().ToString() + "/" + m_AccountCache.GetCapacity().ToString();
+        stats += " Hits: " + m_AccountCache.GetHits().ToString();
+        stats += " Misses: " + m_AccountCache.GetMisses().ToString();
+        stats += " Evictions: " + m_AccountCache.GetEvictions().ToString();
+        return stats;
+    }
+
+    BankingAccountCache GetAccountCache()
+    {
+        return m_AccountCache;
+    }
+
+    // ============================================================
+    // GET DIRTY ACCOUNT COUNT - Accounts waiting to be written
+    // ============================================================
+    int GetDirtyAccountCount()
+    {
+        return m_DirtyAccounts.Count();
+    }
+
     // ============================================================
     // DEPOSIT MONEY - Convert physical currency to bank balance
     // ============================================================
@@ -85,7 +580,7 @@ class BankingManager
     {
         if (!player)
         {
-            Print("[ATM System] Error: Player is null");
+            ModLogger.Error(BANKING_LOG, "Player is null");
             return false;
         }
 
@@ -100,13 +595,19 @@ class BankingManager
         string playerID = player.GetIdentity().GetPlainId();
         BankingAccount account = GetPlayerAccount(playerID, player.GetIdentity().GetName());
 
-        // Check if player has enough physical currency
-        if (!HasEnoughCurrency(player, amount))
+        // Count physical currency in one inventory pass
+        BankingCurrencyCensus census = BankingCurrencyCensus.Take(player);
+        if (!census.PlanRemoval(amount))
         {
             NotificationSystem.Notify(player, "You don't have enough currency in your inventory!");
             return false;
         }
 
+        // Change below the smallest withdraw coin cannot be handed
+        // back; it is credited to the balance instead
+        int unpaidChange = BankingCurrencySpawner.GetUnpayable(census.GetChangeDue());
+        amount += unpaidChange;
+
         // Check if deposit would exceed max balance
         if (!account.CanDeposit(amount))
         {
@@ -114,18 +615,22 @@ class BankingManager
             return false;
         }
 
-        // Remove physical currency from inventory
-        RemoveCurrencyFromPlayer(player, amount);
+        // Remove physical currency from inventory, give back change
+        int change = census.ApplyRemoval(player) - unpaidChange;
+        if (change > 0)
+        {
+            SpawnCurrencyInInventory(player, change);
+        }
 
         // Add to bank balance
         account.Deposit(amount);
 
         // Create transaction record
-        BankingTransaction transaction = new BankingTransaction(playerID, player.GetIdentity().GetName(), amount, "deposit");
+        BankingTransaction transaction = new BankingTransaction(playerID, player.GetIdentity().GetName(), amount, BankingTransactionType.DEPOSIT);
         account.AddTransactionToHistory(transaction);
 
         // Save account
-        SavePlayerAccount(playerID);
+        SavePlayerAccount(playerID, transaction);
 
         // Send updated account to client
         SendAccountToClient(player, account);
@@ -150,7 +655,7 @@ class BankingManager
     {
         if (!player)
         {
-            Print("[ATM System] Error: Player is null");
+            ModLogger.Error(BANKING_LOG, "Player is null");
             return false;
         }
 
@@ -161,6 +666,13 @@ class BankingManager
             return false;
         }
 
+        // Only what the withdraw coins can pay exactly
+        if (BankingCurrencySpawner.GetUnpayable(amount) > 0)
+        {
+            NotificationSystem.Notify(player, "Amount cannot be paid out in the available currency!");
+            return false;
+        }
+
         // Get player account
         string playerID = player.GetIdentity().GetPlainId();
         BankingAccount account = GetPlayerAccount(playerID, player.GetIdentity().GetName());
@@ -187,11 +699,11 @@ class BankingManager
         SpawnCurrencyInInventory(player, amount);
 
         // Create transaction record
-        BankingTransaction transaction = new BankingTransaction(playerID, player.GetIdentity().GetName(), amount, "withdraw");
+        BankingTransaction transaction = new BankingTransaction(playerID, player.GetIdentity().GetName(), amount, BankingTransactionType.WITHDRAW);
         account.AddTransactionToHistory(transaction);
 
         // Save account
-        SavePlayerAccount(playerID);
+        SavePlayerAccount(playerID, transaction);
 
         // Send updated account to client
         SendAccountToClient(player, account);
@@ -216,7 +728,7 @@ class BankingManager
     {
         if (!sender)
         {
-            Print("[ATM System] Error: Sender is null");
+            ModLogger.Error(BANKING_LOG, "Sender is null");
             return false;
         }
 
@@ -241,25 +753,28 @@ class BankingManager
             return false;
         }
 
+        // Reject before debiting if a loaded recipient has no room
+        PlayerBase targetPlayer = FindPlayerByID(targetID);
+        BankingAccount loadedTarget = m_AccountCache.Peek(targetID);
+        if (loadedTarget && !loadedTarget.CanDeposit(amount))
+        {
+            NotificationSystem.Notify(sender, "Recipient's balance is full!");
+            return false;
+        }
+
         // Deduct from sender
         senderAccount.Transfer(amount, fee);
 
         // Create transaction record
-        BankingTransaction transaction = new BankingTransaction(senderID, sender.GetIdentity().GetName(), amount, "transfer");
-        transaction.SetTarget(targetID, "Unknown");  // Will update when target found
+        BankingTransaction transaction = new BankingTransaction(senderID, sender.GetIdentity().GetName(), amount, BankingTransactionType.TRANSFER);
         transaction.SetFee(fee);
         senderAccount.AddTransactionToHistory(transaction);
 
-        // Save sender account
-        SavePlayerAccount(senderID);
+        BankingAccount targetAccount = CreditTransfer(transaction, targetID, targetPlayer);
 
-        // Get or create target account
-        BankingAccount targetAccount = GetPlayerAccount(targetID);
-        targetAccount.Deposit(amount);
-        SavePlayerAccount(targetID);
-
-        // Update transaction with target name
-        transaction.SetTarget(targetID, targetAccount.PlayerName);
+        // Transfers touch two accounts - always write both immediately
+        SavePlayerAccount(senderID, transaction);
+        FlushAccount(senderID);
 
         // Send updated account to sender
         SendAccountToClient(sender, senderAccount);
@@ -280,8 +795,7 @@ class BankingManager
         }
 
         // Notify target (if online)
-        PlayerBase targetPlayer = FindPlayerByID(targetID);
-        if (targetPlayer && GetBankingConfig().NotifyOnReceive)
+        if (targetPlayer && targetAccount && GetBankingConfig().NotifyOnReceive)
         {
             NotificationSystem.Notify(targetPlayer, "Received: " + amount.ToString() + " from " + sender.GetIdentity().GetName());
             SendAccountToClient(targetPlayer, targetAccount);
@@ -290,6 +804,14 @@ class BankingManager
         return true;
     }
 
+    // ============================================================
+    // GET METRICS - Money supply aggregates (admin)
+    // ============================================================
+    BankingMetrics GetMetrics()
+    {
+        return m_Metrics;
+    }
+
     // ============================================================
     // GET BALANCE - Return player's current balance
     // ============================================================
@@ -300,244 +822,187 @@ class BankingManager
     }
 
     // ============================================================
-    // CHECK IF PLAYER HAS ENOUGH CURRENCY IN INVENTORY
+    // SPAWN CURRENCY IN PLAYER INVENTORY
     // ============================================================
-    private bool HasEnoughCurrency(PlayerBase player, int amount)
+    private void SpawnCurrencyInInventory(PlayerBase player, int amount)
     {
-        int totalValue = 0;
-
-        // Check all items in inventory
-        array<ItemBase> items = new array<ItemBase>;
-        player.GetInventory().EnumerateInventory(InventoryTraversalType.PREORDER, items);
-
-        foreach (ItemBase item : items)
-        {
-            // Check if item is accepted currency
-            if (GetBankingConfig().IsCurrencyAccepted(item.GetType()))
-            {
-                // Get item value (assuming item has a "value" property)
-                // This is a simplified version - in production, you'd check for specific properties
-                int value = GetCurrencyValue(item);
-                totalValue += value;
-
-                if (totalValue >= amount)
-                {
-                    return true;  // Early exit
-                }
-            }
-        }
-
-        return totalValue >= amount;
+        // Stacks up to each item's max quantity, overflow goes into one container
+        BankingCurrencySpawner.Spawn(player, amount);
     }
 
     // ============================================================
-    // GET CURRENCY VALUE - Return value of currency item
+    // FIND PLAYER BY ID - Find online player by Steam64 ID
     // ============================================================
-    private int GetCurrencyValue(ItemBase item)
+    private PlayerBase FindPlayerByID(string playerID)
     {
-        // This is a simplified version
-        // In production, you'd check for specific properties or use a mapping
-
-        string className = item.GetType();
+        // O(1) lookup, null if player not online
+        return PlayerRegistry.GetInstance().GetByPlainId(playerID);
+    }
 
-        // Example: Coin_10 = 10, Coin_50 = 50, Coin_100 = 100
-        if (className.Contains("Coin_"))
+    // ============================================================
+    // SEND ACCOUNT TO CLIENT - Update client with latest account data
+    // ============================================================
+    // Sends only what changed since the last update to this client.
+    // History is not included except for new entries - clients page it
+    // in with RequestHistory.
+    void SendAccountToClient(PlayerBase player, BankingAccount account)
+    {
+        if (!player || !player.GetIdentity())
         {
-            string valueStr = className.Substring(5, className.Length() - 5);
-            return valueStr.ToInt();
+            return;
         }
 
-        // Example: Money_Ruble = 1000, Money_Dollar = 100
-        if (className == "Money_Ruble")
+        string playerID = player.GetIdentity().GetPlainId();
+        BankingSyncState state = m_SyncStates.Get(playerID);
+        bool isNew = false;
+
+        if (!state)
         {
-            return 1000;
+            state = new BankingSyncState();
+            m_SyncStates.Set(playerID, state);
+            isNew = true;
         }
-        else if (className == "Money_Dollar")
+
+        BankingAccountDelta delta = state.BuildDelta(account, isNew, GetBankingConfig().HistoryPageSizeMax);
+
+        GetRPCManager().SendRPC("ATM_System", "ReceiveAccountDelta",
+            new Param1<ref BankingAccountDelta>(delta), true, player.GetIdentity());
+    }
+
+    // ============================================================
+    // SEND FULL SYNC - Client reported a revision gap
+    // ============================================================
+    void SendFullSyncToClient(PlayerBase player)
+    {
+        if (!player || !player.GetIdentity())
         {
-            return 100;
+            return;
         }
 
-        return 0;  // Unknown currency
+        string playerID = player.GetIdentity().GetPlainId();
+        m_SyncStates.Remove(playerID);
+
+        BankingAccount account = GetPlayerAccount(playerID, player.GetIdentity().GetName());
+        SendAccountToClient(player, account);
     }
 
     // ============================================================
-    // REMOVE CURRENCY FROM PLAYER INVENTORY
+    // SEND HISTORY PAGE TO CLIENT - One page of history, newest first
     // ============================================================
-    private void RemoveCurrencyFromPlayer(PlayerBase player, int amount)
+    void SendHistoryPageToClient(PlayerBase player, int page, int pageSize)
     {
-        int remaining = amount;
-
-        // Remove currency items until amount is reached
-        while (remaining > 0)
+        if (!player || !player.GetIdentity())
         {
-            array<ItemBase> items = new array<ItemBase>;
-            player.GetInventory().EnumerateInventory(InventoryTraversalType.PREORDER, items);
+            return;
+        }
 
-            bool foundCurrency = false;
+        pageSize = Math.Clamp(pageSize, 1, GetBankingConfig().HistoryPageSizeMax);
 
-            foreach (ItemBase item : items)
-            {
-                if (GetBankingConfig().IsCurrencyAccepted(item.GetType()))
-                {
-                    int value = GetCurrencyValue(item);
-
-                    if (value <= remaining)
-                    {
-                        // Remove entire item
-                        player.GetInventory().RemoveItem(item);
-                        GetGame().ObjectDelete(item);
-                        remaining -= value;
-                        foundCurrency = true;
-                        break;
-                    }
-                    else
-                    {
-                        // This is more complex - you'd need to split the item
-                        // For simplicity, we just remove it
-                        player.GetInventory().RemoveItem(item);
-                        GetGame().ObjectDelete(item);
-                        remaining -= value;
-                        foundCurrency = true;
-                        break;
-                    }
-                }
-            }
+        string playerID = player.GetIdentity().GetPlainId();
+        BankingAccount account = GetPlayerAccount(playerID, player.GetIdentity().GetName());
 
-            if (!foundCurrency)
-            {
-                break;  // No more currency to remove
-            }
-        }
+        // Client value - clamp to the last page before page * pageSize can overflow
+        int lastPage = Math.Max(account.GetHistoryCount() - 1, 0) / pageSize;
+        page = Math.Clamp(page, 0, lastPage);
+
+        array<ref BankingTransaction> entries = new array<ref BankingTransaction>;
+        account.GetHistoryPage(page, pageSize, entries);
+
+        GetRPCManager().SendRPC("ATM_System", "ReceiveHistory",
+            new Param3<int, int, ref BankingTransactionBatch>(page, account.GetHistoryCount(), BankingTransactionCodec.Encode(entries)), true, player.GetIdentity());
     }
 
     // ============================================================
-    // SPAWN CURRENCY IN PLAYER INVENTORY
+    // PROCESS TRANSACTION QUEUE - Drain pending transactions
     // ============================================================
-    private void SpawnCurrencyInInventory(PlayerBase player, int amount)
+    // Processes up to TransactionQueueDrainCount transactions per tick and
+    // stops early once TransactionQueueBudgetMs is spent (at least one per tick)
+    private void ProcessTransactionQueue()
     {
-        int remaining = amount;
-
-        // Spawn 100-coin items (largest denomination)
-        while (remaining >= 100)
+        if (m_TransactionQueue.IsEmpty())
         {
-            ItemBase coin = ItemBase.Cast(player.GetHumanInventory().CreateInInventory("Coin_100"));
-            if (!coin)
-            {
-                // Inventory full, drop on ground
-                vector pos = player.GetPosition();
-                coin = ItemBase.Cast(GetGame().CreateObject("Coin_100", pos));
-            }
-            remaining -= 100;
+            return;  // No transactions to process
         }
 
-        // Spawn 50-coin items
-        while (remaining >= 50)
-        {
-            ItemBase coin = ItemBase.Cast(player.GetHumanInventory().CreateInInventory("Coin_50"));
-            if (!coin)
-            {
-                vector pos = player.GetPosition();
-                coin = ItemBase.Cast(GetGame().CreateObject("Coin_50", pos));
-            }
-            remaining -= 50;
-        }
+        int maxCount = GetBankingConfig().TransactionQueueDrainCount;
+        int budgetMs = GetBankingConfig().TransactionQueueBudgetMs;
+        int startTicks = TickCount(0);
+        int processed = 0;
 
-        // Spawn 10-coin items
-        while (remaining >= 10)
+        while (processed < maxCount && !m_TransactionQueue.IsEmpty())
         {
-            ItemBase coin = ItemBase.Cast(player.GetHumanInventory().CreateInInventory("Coin_10"));
-            if (!coin)
+            // Process oldest transaction (FIFO)
+            BankingTransaction transaction = m_TransactionQueue.Dequeue();
+
+            // Process transaction (implementation depends on your needs)
+            // For now, just mark as completed
+            transaction.MarkCompleted();
+            processed++;
+
+#ifdef DEVELOPER
+            if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.DEBUG))
             {
-                vector pos = player.GetPosition();
-                coin = ItemBase.Cast(GetGame().CreateObject("Coin_10", pos));
+                ModLogger.Debug(BANKING_LOG, "Processed transaction: " + transaction.GetSummary());
             }
-            remaining -= 10;
-        }
+#endif
 
-        // If there's a remainder, spawn 10-coin items for it
-        if (remaining > 0)
-        {
-            ItemBase coin = ItemBase.Cast(player.GetHumanInventory().CreateInInventory("Coin_10"));
-            if (!coin)
+            // TickCount is in 1/10000 ms units
+            if (TickCount(startTicks) / 10000 >= budgetMs)
             {
-                vector pos = player.GetPosition();
-                coin = ItemBase.Cast(GetGame().CreateObject("Coin_10", pos));
+                break;
             }
         }
     }
 
     // ============================================================
-    // FIND PLAYER BY ID - Find online player by Steam64 ID
+    // ADD TRANSACTION TO QUEUE
     // ============================================================
-    private PlayerBase FindPlayerByID(string playerID)
+    // Returns false when the queue is full. The transaction is marked
+    // failed so the caller can reject the request instead of losing it.
+    bool AddTransactionToQueue(BankingTransaction transaction)
     {
-        array<Man> players = new array<Man>;
-        GetGame().GetPlayers(players);
+        if (!m_TransactionQueue.Enqueue(transaction))
+        {
+            transaction.MarkFailed(BankingFailReason.QUEUE_FULL);
+            ModLogger.Warning(BANKING_LOG, "Transaction queue is full! Rejected: " + transaction.GetIdString());
+            return false;
+        }
 
-        foreach (Man man : players)
+#ifdef DEVELOPER
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.DEBUG))
         {
-            PlayerBase player = PlayerBase.Cast(man);
-            if (player && player.GetIdentity().GetPlainId() == playerID)
-            {
-                return player;
-            }
+            ModLogger.Debug(BANKING_LOG, "Transaction added to queue: " + transaction.GetIdString());
         }
+#endif
 
-        return null;  // Player not online
+        return true;
     }
 
     // ============================================================
-    // SEND ACCOUNT TO CLIENT - Update client with latest account data
+    // CAN ACCEPT TRANSACTION - Backpressure check for callers
     // ============================================================
-    private void SendAccountToClient(PlayerBase player, BankingAccount account)
+    bool CanAcceptTransaction()
     {
-        GetRPCManager().SendRPC("ATM_System", "ReceiveAccountData",
-            new Param1<ref BankingAccount>(account), true, player.GetIdentity());
+        return !m_TransactionQueue.IsFull();
     }
 
     // ============================================================
-    // PROCESS TRANSACTION QUEUE - Process pending transactions
+    // GET QUEUE STATS - Depth and wait-time metrics
     // ============================================================
-    private void ProcessTransactionQueue()
+    string GetQueueStats()
     {
-        if (m_TransactionQueue.Count() == 0)
-        {
-            return;  // No transactions to process
-        }
-
-        // Process first transaction in queue (FIFO)
-        BankingTransaction transaction = m_TransactionQueue[0];
-
-        // Process transaction (implementation depends on your needs)
-        // For now, just mark as completed
-        transaction.MarkCompleted();
-
-        // Remove from queue
-        m_TransactionQueue.RemoveOrdered(0);
-
-        if (GetBankingConfig().BankingLogs)
-        {
-            Print("[ATM System] Processed transaction: " + transaction.GetSummary());
-        }
+        string stats = "Depth: " + m_TransactionQueue.Count().ToString() + "/" + m_TransactionQueue.GetCapacity().ToString();
+        stats += " MaxDepth: " + m_TransactionQueue.GetMaxDepth().ToString();
+        stats += " Processed: " + m_TransactionQueue.GetTotalDequeued().ToString();
+        stats += " Rejected: " + m_TransactionQueue.GetTotalRejected().ToString();
+        stats += " AvgWait: " + m_TransactionQueue.GetAverageWaitMs().ToString() + "ms";
+        stats += " MaxWait: " + m_TransactionQueue.GetMaxWaitMs().ToString() + "ms";
+        return stats;
     }
 
-    // ============================================================
-    // ADD TRANSACTION TO QUEUE
-    // ============================================================
-    void AddTransactionToQueue(BankingTransaction transaction)
+    BankingTransactionQueue GetTransactionQueue()
     {
-        if (m_TransactionQueue.Count() >= GetBankingConfig().TransactionQueueSize)
-        {
-            Print("[ATM System] Warning: Transaction queue is full!");
-            return;
-        }
-
-        m_TransactionQueue.Insert(transaction);
-
-        if (GetBankingConfig().BankingLogs)
-        {
-            Print("[ATM System] Transaction added to queue: " + transaction.TransactionID);
-        }
+        return m_TransactionQueue;
     }
 
     // ============================================================
@@ -545,8 +1010,12 @@ class BankingManager
     // ============================================================
     void ClearAccountCache()
     {
+        // Never drop unsaved changes
+        FlushAllDirtyAccounts();
+
         m_AccountCache.Clear();
-        Print("[ATM System] Account cache cleared.");
+        m_Metrics.ForgetAll();
+        ModLogger.Info(BANKING_LOG, "Account cache cleared.");
     }
 
     // ============================================================
@@ -554,11 +1023,16 @@ class BankingManager
     // ============================================================
     void SaveAllAccounts()
     {
-        foreach (string playerID, BankingAccount account : m_AccountCache)
+        array<BankingAccount> accounts = new array<BankingAccount>;
+        m_AccountCache.GetAccounts(accounts);
+
+        foreach (BankingAccount account : accounts)
         {
-            account.Save();
+            WriteSnapshot(account);
         }
 
-        Print("[ATM System] All accounts saved.");
+        m_DirtyAccounts.Clear();
+
+        ModLogger.Info(BANKING_LOG, "All accounts saved.");
     }
 }
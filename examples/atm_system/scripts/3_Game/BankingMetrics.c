@@ -0,0 +1,602 @@
+// ============================================================
+// BANKING METRICS - Running money supply aggregates
+// ============================================================
+// Kept up to date by BankingManager on every account change, so
+// admin questions ("how much money is there", "who is richest")
+// are answered without loading any account:
+// - Total balance and account count
+// - Top MetricsTopK richest accounts
+// - Today's volume (count and amount) per transaction type
+//
+// Only these aggregates are persisted ($profile:Banking/metrics.json).
+// A change is counted against the balance the account had when it
+// was loaded, remembered while the account stays in the cache.
+//
+// The file is marked clean when every counted change is on disk
+// (BankingManager.FlushAllDirtyAccounts). If it is missing or was
+// not clean (crash), the totals are rebuilt in the background by
+// listing one shard and reading a few accounts per tick. The same scan
+// refreshes the top list after a listed account fell behind.
+//
+// Only player (Steam ID) accounts are counted. Transfers still in
+// the credit ledger count once the recipient's account is loaded.
+
+// ============================================================
+// MONEY TOTAL - Sum that does not overflow int
+// ============================================================
+// Enforce Script ints are 32-bit; the server-wide sum is kept as
+// High * 1e9 + Low with 0 <= Low < 1e9.
+class BankingMoneyTotal
+{
+    static const int BASE = 1000000000;
+
+    int High;
+    int Low;
+
+    void Add(int delta)
+    {
+        High += delta / BASE;
+        Low += delta % BASE;
+
+        if (Low >= BASE)
+        {
+            Low -= BASE;
+            High++;
+        }
+        else if (Low < 0)
+        {
+            Low += BASE;
+            High--;
+        }
+    }
+
+    void Reset()
+    {
+        High = 0;
+        Low = 0;
+    }
+
+    string Format()
+    {
+        if (High == 0)
+        {
+            return Low.ToString();
+        }
+
+        return High.ToString() + Low.ToStringLen(9);
+    }
+}
+
+// ============================================================
+// DAILY VOLUME - Per transaction type (BankingTransactionType)
+// ============================================================
+class BankingDailyVolume
+{
+    int Day;                        // Days since 1970-01-01 (UTC)
+    ref array<int> Count;           // Indexed by BankingTransactionType
+    ref array<int> Amount;
+    int Fees;
+
+    void BankingDailyVolume()
+    {
+        Count = new array<int>;
+        Amount = new array<int>;
+        Reset(0);
+    }
+
+    void Reset(int day)
+    {
+        Day = day;
+        Fees = 0;
+        Count.Clear();
+        Amount.Clear();
+
+        for (int type = 0; type <= BankingTransactionType.CREDIT; type++)
+        {
+            Count.Insert(0);
+            Amount.Insert(0);
+        }
+    }
+}
+
+// ============================================================
+// RICH ENTRY - One account of the top list
+// ============================================================
+class BankingRichEntry
+{
+    string PlayerID;
+    string PlayerName;
+    int Balance;
+}
+
+// ============================================================
+// METRICS STATE - metrics.json
+// ============================================================
+class BankingMetricsState
+{
+    ref BankingMoneyTotal Total;
+    int AccountCount;
+    ref array<ref BankingRichEntry> Richest;    // Highest balance first
+    ref BankingDailyVolume Today;
+    bool Clean;                     // Every counted change was on disk when saved
+
+    [NonSerialized()]
+    bool RichestStale;              // A listed account fell behind - rescan needed
+
+    void BankingMetricsState()
+    {
+        Total = new BankingMoneyTotal();
+        AccountCount = 0;
+        Richest = new array<ref BankingRichEntry>;
+        Today = new BankingDailyVolume();
+        Clean = false;
+        RichestStale = false;
+    }
+}
+
+// ============================================================
+// METRICS REPORT - Sent to admins
+// ============================================================
+class BankingMetricsReport
+{
+    string TotalBalance;            // Formatted - may exceed int
+    int AccountCount;
+    bool Complete;                  // False while totals or the top list are rebuilt
+    ref array<ref BankingRichEntry> Richest;
+    ref BankingDailyVolume Today;
+
+    void BankingMetricsReport()
+    {
+        Richest = new array<ref BankingRichEntry>;
+    }
+}
+
+class BankingMetrics
+{
+    static const string METRICS_FILE = "$profile:Banking/metrics.json";
+    static const int SAVE_DELAY_MS = 30000;         // Coalesce saves after changes
+    static const int REBUILD_BATCH = 20;            // Accounts read per rebuild tick
+    static const int RESCAN_INTERVAL_MS = 600000;   // Top list rescans at most every 10 minutes
+
+    protected ref BankingMetricsState m_State;
+
+    // Balance counted in the totals, per cached account
+    protected ref map<string, int> m_Counted;
+
+    protected bool m_SaveScheduled;
+    protected bool m_RescanScheduled;
+    protected int m_LastRebuildTime;
+
+    // Rebuild in progress: listing the store (one shard per tick),
+    // then accounts not read yet and the totals so far
+    protected ref BankingAccountListing m_Listing;
+    protected ref array<string> m_CreatedWhileListing;
+    protected ref array<string> m_RebuildQueue;
+    protected ref map<string, bool> m_RebuildPending;
+    protected ref BankingMetricsState m_Rebuild;
+
+    // ============================================================
+    // CONSTRUCTOR - Load metrics or start a rebuild
+    // ============================================================
+    void BankingMetrics()
+    {
+        m_State = new BankingMetricsState();
+        m_Counted = new map<string, int>;
+        m_SaveScheduled = false;
+        m_RescanScheduled = false;
+        m_LastRebuildTime = 0;
+
+        if (FileExist(METRICS_FILE))
+        {
+            JsonFileLoader<BankingMetricsState>.JsonLoadFile(METRICS_FILE, m_State);
+
+            if (!m_State.Total || !m_State.Richest)
+            {
+                m_State.Total = new BankingMoneyTotal();
+                m_State.Richest = new array<ref BankingRichEntry>;
+                m_State.Clean = false;  // Older file layout
+            }
+
+            if (!m_State.Today)
+            {
+                m_State.Today = new BankingDailyVolume();
+            }
+        }
+
+        if (!m_State.Clean)
+        {
+            StartRebuild();
+        }
+    }
+
+    // ============================================================
+    // ON ACCOUNT LOADED - Remember the balance already counted
+    // ============================================================
+    // Called once the snapshot and journal records are applied.
+    // A stored account is already in the totals; a new one is added.
+    void OnAccountLoaded(BankingAccount account)
+    {
+        if (!account || IsExcluded(account.SteamID64))
+        {
+            return;
+        }
+
+        m_Counted.Set(account.SteamID64, account.Balance);
+
+        if (account.IsNew())
+        {
+            CountChange(account.SteamID64, account.PlayerName, 0, account.Balance, true);
+        }
+    }
+
+    // ============================================================
+    // ON ACCOUNT CHANGED - Cached account modified
+    // ============================================================
+    void OnAccountChanged(BankingAccount account)
+    {
+        if (!account || IsExcluded(account.SteamID64))
+        {
+            return;
+        }
+
+        int oldBalance;
+        if (!m_Counted.Find(account.SteamID64, oldBalance))
+        {
+            // Not loaded through the manager - nothing to compare with
+            m_Counted.Set(account.SteamID64, account.Balance);
+            return;
+        }
+
+        if (oldBalance == account.Balance)
+        {
+            return;
+        }
+
+        m_Counted.Set(account.SteamID64, account.Balance);
+        CountChange(account.SteamID64, account.PlayerName, oldBalance, account.Balance, false);
+    }
+
+    // ============================================================
+    // ON BALANCE CHANGED - Account changed without being cached
+    // ============================================================
+    void OnBalanceChanged(string playerID, string playerName, int oldBalance, int balance)
+    {
+        if (IsExcluded(playerID) || oldBalance == balance)
+        {
+            return;
+        }
+
+        CountChange(playerID, playerName, oldBalance, balance, false);
+    }
+
+    // ============================================================
+    // ON TRANSACTION - Count a completed transaction in today's volume
+    // ============================================================
+    void OnTransaction(BankingTransaction transaction)
+    {
+        if (!transaction || IsExcluded(transaction.PlayerID))
+        {
+            return;
+        }
+
+        BankingDailyVolume today = GetToday();
+        int type = transaction.Type;
+        if (type < 0 || type >= today.Count.Count())
+        {
+            return;
+        }
+
+        today.Count[type] = today.Count[type] + 1;
+        today.Amount[type] = today.Amount[type] + transaction.Amount;
+        today.Fees += transaction.Fee;
+        ScheduleSave();
+    }
+
+    // ============================================================
+    // FORGET - Account left the account cache
+    // ============================================================
+    void Forget(string playerID)
+    {
+        m_Counted.Remove(playerID);
+    }
+
+    void ForgetAll()
+    {
+        m_Counted.Clear();
+    }
+
+    // ============================================================
+    // READ - O(1), no account is loaded
+    // ============================================================
+    string GetTotalBalance()
+    {
+        return m_State.Total.Format();
+    }
+
+    int GetAccountCount()
+    {
+        return m_State.AccountCount;
+    }
+
+    bool IsComplete()
+    {
+        return !m_RebuildQueue && !m_State.RichestStale;
+    }
+
+    BankingMetricsReport GetReport()
+    {
+        BankingMetricsReport report = new BankingMetricsReport();
+        report.TotalBalance = m_State.Total.Format();
+        report.AccountCount = m_State.AccountCount;
+        report.Complete = IsComplete();
+        report.Today = GetToday();
+
+        foreach (BankingRichEntry entry : m_State.Richest)
+        {
+            report.Richest.Insert(entry);
+        }
+
+        return report;
+    }
+
+    // ============================================================
+    // SAVE - Aggregates only, O(MetricsTopK)
+    // ============================================================
+    void Save()
+    {
+        m_SaveScheduled = false;
+        JsonFileLoader<BankingMetricsState>.JsonSaveFile(METRICS_FILE, m_State);
+    }
+
+    // Call once every counted change is on disk
+    void SaveClean()
+    {
+        // Totals from an unfinished rebuild are not trusted after a restart
+        m_State.Clean = !m_RebuildQueue;
+        Save();
+    }
+
+    protected void ScheduleSave()
+    {
+        if (m_SaveScheduled)
+        {
+            return;
+        }
+
+        m_SaveScheduled = true;
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(Save, SAVE_DELAY_MS, false);
+    }
+
+    // ============================================================
+    // REBUILD - Read every stored account, a few per tick
+    // ============================================================
+    protected void StartRebuild()
+    {
+        m_RescanScheduled = false;
+        if (m_RebuildQueue)
+        {
+            return;
+        }
+
+        // Non-null for the whole rebuild; filled once listing is done
+        m_RebuildQueue = new array<string>;
+        m_Listing = new BankingAccountListing();
+        m_CreatedWhileListing = new array<string>;
+
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(RebuildStep, 1, true);
+    }
+
+    // Listing done: queue every account and start counting
+    protected void StartReading()
+    {
+        array<string> ids = m_Listing.GetIDs();
+
+        // Created during listing, possibly in a shard already listed
+        foreach (string createdID : m_CreatedWhileListing)
+        {
+            ids.Insert(createdID);
+        }
+
+        m_RebuildPending = new map<string, bool>;
+        foreach (string playerID : ids)
+        {
+            if (!IsExcluded(playerID) && !m_RebuildPending.Contains(playerID))
+            {
+                m_RebuildPending.Set(playerID, true);
+                m_RebuildQueue.Insert(playerID);
+            }
+        }
+
+        m_Listing = null;
+        m_CreatedWhileListing = null;
+        m_Rebuild = new BankingMetricsState();
+
+        ModLogger.Info(BANKING_LOG, "Building money supply metrics: " + m_RebuildQueue.Count().ToString() + " account(s)");
+    }
+
+    protected void RebuildStep()
+    {
+        // Changes while listing are read with the account later
+        if (m_Listing)
+        {
+            if (m_Listing.Step(0))
+            {
+                StartReading();
+            }
+
+            return;
+        }
+
+        BankingManager manager = BankingManager.GetInstance();
+        int batch = Math.Min(REBUILD_BATCH, m_RebuildQueue.Count());
+
+        // Read-only: the account cache, credits and files are left alone
+        for (int i = 0; i < batch; i++)
+        {
+            int last = m_RebuildQueue.Count() - 1;
+            string playerID = m_RebuildQueue[last];
+            m_RebuildQueue.Remove(last);
+            m_RebuildPending.Remove(playerID);
+
+            BankingAccount account = manager.ReadAccount(playerID);
+            if (account)
+            {
+                Apply(m_Rebuild, playerID, account.PlayerName, 0, account.Balance, true);
+            }
+        }
+
+        if (m_RebuildQueue.Count() > 0)
+        {
+            return;
+        }
+
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).Remove(RebuildStep);
+
+        m_State.Total = m_Rebuild.Total;
+        m_State.AccountCount = m_Rebuild.AccountCount;
+        m_State.Richest = m_Rebuild.Richest;
+        m_State.RichestStale = m_Rebuild.RichestStale;
+
+        m_RebuildQueue = null;
+        m_RebuildPending = null;
+        m_Rebuild = null;
+        m_LastRebuildTime = GetGame().GetTime();
+        Save();
+
+        ModLogger.Info(BANKING_LOG, "Money supply metrics ready: " + GetAccountCount().ToString() + " account(s), total " + GetTotalBalance());
+
+        if (m_State.RichestStale)
+        {
+            ScheduleRescan();
+        }
+    }
+
+    // Top list refresh; rate limited as it reads every account
+    protected void ScheduleRescan()
+    {
+        if (m_RescanScheduled || m_RebuildQueue)
+        {
+            return;
+        }
+
+        int delay = Math.Max(m_LastRebuildTime + RESCAN_INTERVAL_MS - GetGame().GetTime(), 1);
+
+        m_RescanScheduled = true;
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(StartRebuild, delay, false);
+    }
+
+    // ============================================================
+    // HELPERS
+    // ============================================================
+    protected void CountChange(string playerID, string playerName, int oldBalance, int balance, bool created)
+    {
+        bool wasClean = m_State.Clean;
+        m_State.Clean = false;
+
+        Apply(m_State, playerID, playerName, oldBalance, balance, created);
+
+        if (m_Listing && created)
+        {
+            m_CreatedWhileListing.Insert(playerID);
+        }
+
+        // Accounts the rebuild has already read
+        if (m_Rebuild && !m_RebuildPending.Contains(playerID))
+        {
+            Apply(m_Rebuild, playerID, playerName, oldBalance, balance, created);
+        }
+
+        if (m_State.RichestStale)
+        {
+            ScheduleRescan();
+        }
+
+        // The file must stop claiming clean before this change is on disk
+        if (wasClean)
+        {
+            Save();
+        }
+        else
+        {
+            ScheduleSave();
+        }
+    }
+
+    protected void Apply(BankingMetricsState state, string playerID, string playerName, int oldBalance, int balance, bool created)
+    {
+        state.Total.Add(balance - oldBalance);
+
+        if (created)
+        {
+            state.AccountCount++;
+        }
+
+        UpdateRichest(state, playerID, playerName, balance, balance < oldBalance);
+    }
+
+    // Keeps state.Richest sorted; marks it stale when a listed account
+    // falls to the bottom while unlisted accounts could beat it
+    protected void UpdateRichest(BankingMetricsState state, string playerID, string playerName, int balance, bool dropped)
+    {
+        array<ref BankingRichEntry> richest = state.Richest;
+        int topK = Math.Max(GetBankingConfig().MetricsTopK, 1);
+
+        int index = -1;
+        for (int i = 0; i < richest.Count(); i++)
+        {
+            if (richest[i].PlayerID == playerID)
+            {
+                index = i;
+                break;
+            }
+        }
+
+        if (index >= 0)
+        {
+            richest.RemoveOrdered(index);
+        }
+        else if (richest.Count() >= topK && balance <= richest[richest.Count() - 1].Balance)
+        {
+            return;  // Not rich enough
+        }
+
+        int position = 0;
+        while (position < richest.Count() && richest[position].Balance >= balance)
+        {
+            position++;
+        }
+
+        BankingRichEntry entry = new BankingRichEntry();
+        entry.PlayerID = playerID;
+        entry.PlayerName = playerName;
+        entry.Balance = balance;
+        richest.InsertAt(entry, position);
+
+        while (richest.Count() > topK)
+        {
+            richest.Remove(richest.Count() - 1);
+        }
+
+        if (index >= 0 && dropped && position == richest.Count() - 1 && state.AccountCount > richest.Count())
+        {
+            state.RichestStale = true;
+        }
+    }
+
+    protected BankingDailyVolume GetToday()
+    {
+        int day = BankingClock.GetDay();
+        if (m_State.Today.Day != day)
+        {
+            m_State.Today.Reset(day);
+        }
+
+        return m_State.Today;
+    }
+
+    // Only player accounts are part of the economy (not benchmark accounts)
+    protected bool IsExcluded(string playerID)
+    {
+        return !BankingAccountStore.IsSteamID(playerID);
+    }
+}
@@ -15,12 +15,40 @@ modded class CustomMission
 
         // Register RPC handlers
         GetRPCManager().AddRPC("ATM_System", "RequestBankData", this, SingeplayerExecutionType.Client);
-        GetRPCManager().AddRPC("ATM_System", "ReceiveAccountData", this, SingeplayerExecutionType.Client);
+        GetRPCManager().AddRPC("ATM_System", "ReceiveAccountDelta", this, SingeplayerExecutionType.Client);
+        GetRPCManager().AddRPC("ATM_System", "RequestFullSync", this, SingeplayerExecutionType.Server);
+        GetRPCManager().AddRPC("ATM_System", "RequestHistory", this, SingeplayerExecutionType.Server);
+        GetRPCManager().AddRPC("ATM_System", "ReceiveHistory", this, SingeplayerExecutionType.Client);
         GetRPCManager().AddRPC("ATM_System", "DepositMoney", this, SingeplayerExecutionType.Server);
         GetRPCManager().AddRPC("ATM_System", "WithdrawMoney", this, SingeplayerExecutionType.Server);
         GetRPCManager().AddRPC("ATM_System", "TransferMoney", this, SingeplayerExecutionType.Server);
+        GetRPCManager().AddRPC("ATM_System", "RequestBankMetrics", this, SingeplayerExecutionType.Server);
+        GetRPCManager().AddRPC("ATM_System", "ReceiveBankMetrics", this, SingeplayerExecutionType.Client);
+        GetRPCManager().AddRPC("ATM_System", "StartBulkOperation", this, SingeplayerExecutionType.Server);
+        GetRPCManager().AddRPC("ATM_System", "CancelBulkOperation", this, SingeplayerExecutionType.Server);
+        GetRPCManager().AddRPC("ATM_System", "RequestBulkStatus", this, SingeplayerExecutionType.Server);
+        GetRPCManager().AddRPC("ATM_System", "ReceiveBulkStatus", this, SingeplayerExecutionType.Client);
 
-        Print("[ATM System] RPC handlers registered.");
+        ModLogger.Info(BANKING_LOG, "RPC handlers registered.");
+
+        // Benchmark requested on the command line
+        if (GetGame().IsServer() && IsCLIParam("bankingBenchmark"))
+        {
+            BankingBenchmark.GetInstance().Start();
+        }
+    }
+
+    // ============================================================
+    // ON MISSION FINISH - Write pending accounts before shutdown
+    // ============================================================
+    override void OnMissionFinish()
+    {
+        if (GetGame().IsServer())
+        {
+            BankingManager.GetInstance().FlushAllDirtyAccounts();
+        }
+
+        super.OnMissionFinish();
     }
 
     // ============================================================
@@ -40,38 +68,121 @@ modded class CustomMission
         BankingAccount account = BankingManager.GetInstance().GetPlayerAccount(playerID, sender.GetIdentity().GetName());
 
         // Send account data back to client
-        GetRPCManager().SendRPC("ATM_System", "ReceiveAccountData",
-            new Param1<ref BankingAccount>(account), true, sender.GetIdentity());
+        BankingManager.GetInstance().SendAccountToClient(sender, account);
 
         // Open bank UI (simplified - just shows notification for now)
         NotificationSystem.Notify(sender, "Balance: " + account.Balance.ToString());
     }
 
     // ============================================================
-    // RECEIVE ACCOUNT DATA - Client receives updated account data
+    // RECEIVE ACCOUNT DELTA - Client receives account changes
     // ============================================================
-    void ReceiveAccountData(CallType type, ParamsReadContext ctx, PlayerBase sender)
+    void ReceiveAccountDelta(CallType type, ParamsReadContext ctx, PlayerBase sender)
     {
         if (type != CallType.Client)
         {
             return;
         }
 
-        // Read account data from RPC
-        Param1<ref BankingAccount> data;
+        // Read delta from RPC
+        Param1<ref BankingAccountDelta> data;
         if (!ctx.Read(data))
         {
             return;
         }
 
-        BankingAccount account = data.param1;
+        BankingClientAccountCache cache = BankingClientAccountCache.GetInstance();
+        int result = cache.ApplyDelta(data.param1);
+
+        // Revision gap - ask server for the complete account
+        if (result == BankingDeltaResult.RESYNC)
+        {
+            GetRPCManager().SendRPC("ATM_System", "RequestFullSync", null, true);
+            return;
+        }
+
+        // Client and server versions differ - logged once by the cache
+        if (result != BankingDeltaResult.APPLIED)
+        {
+            return;
+        }
+
+        BankingAccountSummary account = cache.GetAccount();
+
+        // Update bank menu if it is open
+        BankingMenu menu = BankingMenu.Cast(GetGame().GetUIManager().GetMenu());
+        if (menu)
+        {
+            menu.SetAccount(account);
+        }
 
-        // Update local account data (for UI display)
-        // This is where you would update the UI
-        // For now, just show notification
         NotificationSystem.Notify(sender, "Account Updated. Balance: " + account.Balance.ToString());
     }
 
+    // ============================================================
+    // REQUEST FULL SYNC - Client cache is out of date
+    // ============================================================
+    void RequestFullSync(CallType type, ParamsReadContext ctx, PlayerBase sender)
+    {
+        if (type != CallType.Server)
+        {
+            return;
+        }
+
+        BankingManager.GetInstance().SendFullSyncToClient(sender);
+    }
+
+    // ============================================================
+    // REQUEST HISTORY - Client requests one page of history
+    // ============================================================
+    void RequestHistory(CallType type, ParamsReadContext ctx, PlayerBase sender)
+    {
+        if (type != CallType.Server)
+        {
+            return;
+        }
+
+        // Read page and page size from RPC
+        Param2<int, int> data;
+        if (!ctx.Read(data))
+        {
+            return;
+        }
+
+        BankingManager.GetInstance().SendHistoryPageToClient(sender, data.param1, data.param2);
+    }
+
+    // ============================================================
+    // RECEIVE HISTORY - Client receives one page of history
+    // ============================================================
+    void ReceiveHistory(CallType type, ParamsReadContext ctx, PlayerBase sender)
+    {
+        if (type != CallType.Client)
+        {
+            return;
+        }
+
+        // Read page, total count and entries from RPC
+        Param3<int, int, ref BankingTransactionBatch> data;
+        if (!ctx.Read(data))
+        {
+            return;
+        }
+
+        array<ref BankingTransaction> entries = new array<ref BankingTransaction>;
+        if (!BankingTransactionCodec.Decode(data.param3, entries))
+        {
+            ModLogger.Warning(BANKING_LOG, "Received malformed history page");
+            return;
+        }
+
+        BankingMenu menu = BankingMenu.Cast(GetGame().GetUIManager().GetMenu());
+        if (menu)
+        {
+            menu.SetHistoryPage(data.param1, data.param2, entries);
+        }
+    }
+
     // ============================================================
     // DEPOSIT MONEY - Server handles deposit request
     // ============================================================
@@ -91,8 +202,8 @@ modded class CustomMission
 
         int amount = data.param1;
 
-        // Execute deposit
-        BankingManager.GetInstance().DepositMoney(sender, amount);
+        // Rate limit and merge with other deposits this frame
+        BankingRequestThrottle.GetInstance().Submit(sender, BankingRequestType.DEPOSIT, amount);
     }
 
     // ============================================================
@@ -114,8 +225,8 @@ modded class CustomMission
 
         int amount = data.param1;
 
-        // Execute withdraw
-        BankingManager.GetInstance().WithdrawMoney(sender, amount);
+        // Rate limit and merge with other withdrawals this frame
+        BankingRequestThrottle.GetInstance().Submit(sender, BankingRequestType.WITHDRAW, amount);
     }
 
     // ============================================================
@@ -138,7 +249,149 @@ modded class CustomMission
         string targetID = data.param1;
         int amount = data.param2;
 
-        // Execute transfer
-        BankingManager.GetInstance().TransferMoney(sender, targetID, amount);
+        // Rate limit and merge with other transfers to the same target this frame
+        BankingRequestThrottle.GetInstance().Submit(sender, BankingRequestType.TRANSFER, amount, targetID);
+    }
+
+    // ============================================================
+    // REQUEST BANK METRICS - Admin asks for money supply figures
+    // ============================================================
+    void RequestBankMetrics(CallType type, ParamsReadContext ctx, PlayerBase sender)
+    {
+        if (!IsBankingAdmin(type, sender))
+        {
+            return;
+        }
+
+        BankingMetricsReport report = BankingManager.GetInstance().GetMetrics().GetReport();
+        GetRPCManager().SendRPC("ATM_System", "ReceiveBankMetrics", new Param1<ref BankingMetricsReport>(report), true, sender.GetIdentity());
+    }
+
+    // ============================================================
+    // RECEIVE BANK METRICS - Admin client receives the report
+    // ============================================================
+    void ReceiveBankMetrics(CallType type, ParamsReadContext ctx, PlayerBase sender)
+    {
+        if (type != CallType.Client)
+        {
+            return;
+        }
+
+        Param1<ref BankingMetricsReport> data;
+        if (!ctx.Read(data))
+        {
+            return;
+        }
+
+        BankingMetricsReport report = data.param1;
+        string status = "";
+        if (!report.Complete)
+        {
+            status = " (index still building)";
+        }
+
+        ModLogger.Info(BANKING_LOG, "Money supply: " + report.TotalBalance + " in " + report.AccountCount.ToString() + " account(s)" + status);
+
+        for (int i = 0; i < report.Richest.Count(); i++)
+        {
+            BankingRichEntry rich = report.Richest[i];
+            ModLogger.Info(BANKING_LOG, "  #" + (i + 1).ToString() + " " + rich.PlayerName + " (" + rich.PlayerID + "): " + rich.Balance.ToString());
+        }
+
+        BankingDailyVolume today = report.Today;
+        for (int t = BankingTransactionType.DEPOSIT; t < today.Count.Count(); t++)
+        {
+            ModLogger.Info(BANKING_LOG, "  Today " + BankingTransaction.GetTypeName(t) + ": " + today.Count[t].ToString() + " x, " + today.Amount[t].ToString());
+        }
+
+        ModLogger.Info(BANKING_LOG, "  Today fees: " + today.Fees.ToString());
+    }
+
+    // ============================================================
+    // START BULK OPERATION - Admin applies a transform to all accounts
+    // ============================================================
+    // param1: BankingBulkTransform class (e.g. "BankingInterestTransform")
+    // param2: Transform value (wipe balance, interest percent, cap)
+    void StartBulkOperation(CallType type, ParamsReadContext ctx, PlayerBase sender)
+    {
+        if (!IsBankingAdmin(type, sender))
+        {
+            return;
+        }
+
+        Param2<string, float> data;
+        if (!ctx.Read(data))
+        {
+            return;
+        }
+
+        ModLogger.Info(BANKING_LOG, "Bulk operation requested by " + sender.GetIdentity().GetName() + ": " + data.param1 + "(" + data.param2.ToString() + ")");
+        BankingBulkOperation.GetInstance().Start(data.param1, data.param2);
+        SendBulkStatus(sender);
+    }
+
+    // ============================================================
+    // CANCEL BULK OPERATION
+    // ============================================================
+    void CancelBulkOperation(CallType type, ParamsReadContext ctx, PlayerBase sender)
+    {
+        if (!IsBankingAdmin(type, sender))
+        {
+            return;
+        }
+
+        BankingBulkOperation.GetInstance().Cancel();
+        SendBulkStatus(sender);
+    }
+
+    // ============================================================
+    // REQUEST BULK STATUS - Progress and ETA
+    // ============================================================
+    void RequestBulkStatus(CallType type, ParamsReadContext ctx, PlayerBase sender)
+    {
+        if (!IsBankingAdmin(type, sender))
+        {
+            return;
+        }
+
+        SendBulkStatus(sender);
+    }
+
+    void ReceiveBulkStatus(CallType type, ParamsReadContext ctx, PlayerBase sender)
+    {
+        if (type != CallType.Client)
+        {
+            return;
+        }
+
+        Param1<string> data;
+        if (!ctx.Read(data))
+        {
+            return;
+        }
+
+        ModLogger.Info(BANKING_LOG, "Bulk operation " + data.param1);
+    }
+
+    protected void SendBulkStatus(PlayerBase admin)
+    {
+        string progress = BankingBulkOperation.GetInstance().GetProgress();
+        GetRPCManager().SendRPC("ATM_System", "ReceiveBulkStatus", new Param1<string>(progress), true, admin.GetIdentity());
+    }
+
+    protected bool IsBankingAdmin(CallType type, PlayerBase sender)
+    {
+        if (type != CallType.Server || !sender || !sender.GetIdentity())
+        {
+            return false;
+        }
+
+        if (!GetBankingConfig().IsAdmin(sender.GetIdentity().GetPlainId()))
+        {
+            ModLogger.Warning(BANKING_LOG, "Admin request from non-admin " + sender.GetIdentity().GetPlainId());
+            return false;
+        }
+
+        return true;
     }
 }
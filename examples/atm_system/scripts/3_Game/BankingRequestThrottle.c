@@ -0,0 +1,342 @@
+// ============================================================
+// BANKING REQUEST THROTTLE - Rate limiting and coalescing for RPCs
+// ============================================================
+// Deposit, withdraw and transfer RPCs pass through here before any
+// inventory or account work:
+// - Token bucket per player: RpcBurst requests at once, refilled at
+//   RpcRefillPerSecond. Requests without a token are dropped.
+//   Buckets outlive a disconnect until they would be full again, so
+//   reconnecting does not reset the limit.
+// - Coalescing: requests of the same type (and same target) from
+//   one player within one frame are merged into one operation, so
+//   they cost one inventory scan, one save and one sync.
+
+enum BankingRequestType
+{
+    DEPOSIT,
+    WITHDRAW,
+    TRANSFER
+}
+
+// ============================================================
+// TOKEN BUCKET - Request budget of one player
+// ============================================================
+class BankingTokenBucket
+{
+    float Tokens;
+    int LastRefillTime;     // GetGame().GetTime() (ms)
+    bool Warned;            // Player already told about the limit
+
+    void BankingTokenBucket(float tokens, int now)
+    {
+        Tokens = tokens;
+        LastRefillTime = now;
+        Warned = false;
+    }
+}
+
+// ============================================================
+// PENDING REQUEST - Merged requests waiting for the end of frame
+// ============================================================
+class BankingPendingRequest
+{
+    PlayerBase Player;      // Not ref - the player may disconnect meanwhile
+    int Type;               // BankingRequestType
+    int Amount;
+    string TargetID;
+    int Merged;             // Requests folded into this one
+
+    void BankingPendingRequest(PlayerBase player, int type, int amount, string targetID)
+    {
+        Player = player;
+        Type = type;
+        Amount = amount;
+        TargetID = targetID;
+        Merged = 1;
+    }
+}
+
+class BankingRequestThrottle
+{
+    protected ref map<string, ref BankingTokenBucket> m_Buckets;
+    protected ref map<string, ref BankingPendingRequest> m_Pending;
+    protected ref array<string> m_PendingOrder;     // Players in arrival order
+    protected bool m_FlushScheduled;
+    protected bool m_PruneScheduled;
+
+    // Statistics
+    protected int m_Accepted;
+    protected int m_Rejected;
+    protected int m_Coalesced;
+
+    private static ref BankingRequestThrottle m_Instance;
+
+    // ============================================================
+    // GET INSTANCE - Singleton pattern
+    // ============================================================
+    static BankingRequestThrottle GetInstance()
+    {
+        if (!m_Instance)
+        {
+            m_Instance = new BankingRequestThrottle();
+        }
+
+        return m_Instance;
+    }
+
+    void BankingRequestThrottle()
+    {
+        m_Buckets = new map<string, ref BankingTokenBucket>;
+        m_Pending = new map<string, ref BankingPendingRequest>;
+        m_PendingOrder = new array<string>;
+        m_FlushScheduled = false;
+        m_PruneScheduled = false;
+    }
+
+    // ============================================================
+    // SUBMIT - Rate limit, then queue or merge a request
+    // ============================================================
+    // Returns false if the request was dropped by the rate limit
+    bool Submit(PlayerBase player, int type, int amount, string targetID = "")
+    {
+        if (!player || !player.GetIdentity())
+        {
+            return false;
+        }
+
+        BankingConfig config = GetBankingConfig();
+        string playerID = player.GetIdentity().GetPlainId();
+
+        if (config.RpcRateLimitEnabled && !TryConsume(player, playerID))
+        {
+            m_Rejected++;
+            return false;
+        }
+
+        // Each request must be valid on its own before it is merged -
+        // otherwise withdraw 5000 + withdraw -4000 becomes withdraw 1000
+        if (!config.IsValidTransactionAmount(amount))
+        {
+            m_Rejected++;
+            NotificationSystem.Notify(player, "Invalid amount.");
+            return false;
+        }
+
+        m_Accepted++;
+
+        if (!config.RpcCoalesceEnabled)
+        {
+            Execute(new BankingPendingRequest(player, type, amount, targetID));
+            return true;
+        }
+
+        BankingPendingRequest pending = m_Pending.Get(playerID);
+        if (pending && CanMerge(pending, type, amount, targetID))
+        {
+            pending.Amount += amount;
+            pending.Merged++;
+            m_Coalesced++;
+            return true;
+        }
+
+        // Different request - run the earlier one first to keep order
+        if (pending)
+        {
+            FlushPlayer(playerID);
+        }
+
+        m_Pending.Set(playerID, new BankingPendingRequest(player, type, amount, targetID));
+        m_PendingOrder.Insert(playerID);
+
+        if (!m_FlushScheduled)
+        {
+            m_FlushScheduled = true;
+            GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(FlushPending, 0, false);
+        }
+
+        return true;
+    }
+
+    // ============================================================
+    // FLUSH PENDING - Execute merged requests (end of frame)
+    // ============================================================
+    void FlushPending()
+    {
+        m_FlushScheduled = false;
+
+        // Requests submitted while executing go to the next flush
+        array<string> order = m_PendingOrder;
+        m_PendingOrder = new array<string>;
+
+        foreach (string playerID : order)
+        {
+            FlushPlayer(playerID);
+        }
+    }
+
+    // ============================================================
+    // FORGET - Drop pending requests of a disconnected player
+    // ============================================================
+    // The token bucket stays until it has refilled (PruneBuckets)
+    void Forget(string playerID)
+    {
+        m_Pending.Remove(playerID);
+
+        if (!m_PruneScheduled && m_Buckets.Contains(playerID))
+        {
+            m_PruneScheduled = true;
+            GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(PruneBuckets, GetBucketTTL(), false);
+        }
+    }
+
+    // ============================================================
+    // PRUNE BUCKETS - Remove buckets that are full again
+    // ============================================================
+    // A full bucket behaves exactly like a new one, so dropping it
+    // does not give anyone extra requests
+    void PruneBuckets()
+    {
+        m_PruneScheduled = false;
+
+        int now = GetGame().GetTime();
+        int ttl = GetBucketTTL();
+
+        array<string> expired = new array<string>;
+        foreach (string playerID, BankingTokenBucket bucket : m_Buckets)
+        {
+            if (now - bucket.LastRefillTime >= ttl)
+            {
+                expired.Insert(playerID);
+            }
+        }
+
+        foreach (string expiredID : expired)
+        {
+            m_Buckets.Remove(expiredID);
+        }
+
+        // Buckets of recently active players - check again later
+        if (m_Buckets.Count() > 0)
+        {
+            m_PruneScheduled = true;
+            GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(PruneBuckets, ttl, false);
+        }
+    }
+
+    // ============================================================
+    // STATISTICS
+    // ============================================================
+    string GetStats()
+    {
+        return "Accepted: " + m_Accepted.ToString() + ", Rejected: " + m_Rejected.ToString() + ", Coalesced: " + m_Coalesced.ToString();
+    }
+
+    void ResetStats()
+    {
+        m_Accepted = 0;
+        m_Rejected = 0;
+        m_Coalesced = 0;
+    }
+
+    // ============================================================
+    // HELPERS
+    // ============================================================
+    protected bool TryConsume(PlayerBase player, string playerID)
+    {
+        BankingConfig config = GetBankingConfig();
+        int now = GetGame().GetTime();
+        float burst = Math.Max(config.RpcBurst, 1);
+
+        BankingTokenBucket bucket = m_Buckets.Get(playerID);
+        if (!bucket)
+        {
+            bucket = new BankingTokenBucket(burst, now);
+            m_Buckets.Set(playerID, bucket);
+        }
+
+        float elapsed = now - bucket.LastRefillTime;
+        bucket.Tokens = Math.Min(burst, bucket.Tokens + elapsed * config.RpcRefillPerSecond / 1000.0);
+        bucket.LastRefillTime = now;
+
+        if (bucket.Tokens < 1)
+        {
+            // Tell the player once per throttled burst, not per request
+            if (!bucket.Warned)
+            {
+                bucket.Warned = true;
+                NotificationSystem.Notify(player, "Too many requests, please slow down.");
+            }
+
+            return false;
+        }
+
+        bucket.Tokens -= 1;
+        bucket.Warned = false;
+        return true;
+    }
+
+    // Time for an empty bucket to refill completely (ms)
+    protected int GetBucketTTL()
+    {
+        BankingConfig config = GetBankingConfig();
+        float burst = Math.Max(config.RpcBurst, 1);
+        float refill = Math.Max(config.RpcRefillPerSecond, 0.01);
+
+        return Math.Max(burst / refill * 1000, 1000);
+    }
+
+    protected bool CanMerge(BankingPendingRequest pending, int type, int amount, string targetID)
+    {
+        if (pending.Type != type || pending.TargetID != targetID)
+        {
+            return false;
+        }
+
+        // Merged amount must still be a valid single transaction
+        return pending.Amount + amount <= GetBankingConfig().MaxSingleTransaction;
+    }
+
+    protected void FlushPlayer(string playerID)
+    {
+        BankingPendingRequest pending = m_Pending.Get(playerID);
+        if (!pending)
+        {
+            return;
+        }
+
+        m_Pending.Remove(playerID);
+        Execute(pending);
+    }
+
+    protected void Execute(BankingPendingRequest request)
+    {
+        if (!request.Player || !request.Player.GetIdentity())
+        {
+            return;
+        }
+
+        BankingManager manager = BankingManager.GetInstance();
+
+        switch (request.Type)
+        {
+            case BankingRequestType.DEPOSIT:
+                manager.DepositMoney(request.Player, request.Amount);
+                break;
+
+            case BankingRequestType.WITHDRAW:
+                manager.WithdrawMoney(request.Player, request.Amount);
+                break;
+
+            case BankingRequestType.TRANSFER:
+                manager.TransferMoney(request.Player, request.TargetID, request.Amount);
+                break;
+        }
+
+#ifdef DEVELOPER
+        if (request.Merged > 1 && ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug(BANKING_LOG, "Coalesced " + request.Merged.ToString() + " request(s) from " + request.Player.GetIdentity().GetName());
+        }
+#endif
+    }
+}
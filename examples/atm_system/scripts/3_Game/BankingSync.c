@@ -0,0 +1,368 @@
+// ============================================================
+// BANKING SYNC - Delta account sync protocol
+// ============================================================
+// The server remembers what it last sent to each client
+// (BankingSyncState) and sends only fields that changed since then,
+// plus transactions added to history since the last update.
+//
+// Every update carries the revision it is based on. The client
+// applies it only if that matches its cached revision; otherwise
+// it asks for a full resync (RequestFullSync RPC). A delta with another
+// protocol version is logged once and updates stop - resyncing would
+// not fix a client/server version mismatch.
+
+// Protocol version - bump when BankingAccountDelta changes
+static const int BANKING_SYNC_PROTOCOL = 3;
+
+// ============================================================
+// DELTA FIELDS - Bitmask of fields present in a delta
+// ============================================================
+enum BankingDeltaField
+{
+    FULL = 1,           // Complete state, client replaces its cache
+    IDENTITY = 2,       // SteamID64, PlayerName
+    BALANCE = 4,
+    MAX_BALANCE = 8,
+    DAILY_WITHDRAWAL = 16,
+    HISTORY = 32        // NewHistory + HistoryCount
+}
+
+// ============================================================
+// ACCOUNT DELTA - One update sent to a client
+// ============================================================
+// Only fields whose bit is set in Fields go on the wire: their values
+// are appended to Values (ints) and Text (strings) in bit order.
+//   IDENTITY         -> Text: SteamID64, PlayerName
+//   BALANCE          -> Values: Balance
+//   MAX_BALANCE      -> Values: MaxBalance
+//   DAILY_WITHDRAWAL -> Values: remaining today (-1 = unlimited)
+//   HISTORY or FULL  -> Values: HistoryCount
+//   HISTORY          -> NewHistory (empty batch otherwise)
+class BankingAccountDelta
+{
+    int Protocol;
+    int BaseRevision;               // Revision the client must have
+    int Revision;                   // Revision after applying
+    int Fields;                     // BankingDeltaField bits
+    ref array<int> Values;
+    ref array<string> Text;
+    ref BankingTransactionBatch NewHistory;  // Oldest first (BankingTransactionCodec)
+
+    [NonSerialized()]
+    protected int m_ValueIndex;
+
+    [NonSerialized()]
+    protected int m_TextIndex;
+
+    void BankingAccountDelta()
+    {
+        Protocol = BANKING_SYNC_PROTOCOL;
+        Fields = 0;
+        Values = new array<int>;
+        Text = new array<string>;
+        NewHistory = new BankingTransactionBatch();
+    }
+
+    bool Has(int field)
+    {
+        return (Fields & field) != 0;
+    }
+
+    void WriteValue(int value)
+    {
+        Values.Insert(value);
+    }
+
+    void WriteText(string value)
+    {
+        Text.Insert(value);
+    }
+
+    // Read back in write order; false if the delta is short
+    bool ReadValue(out int value)
+    {
+        if (m_ValueIndex >= Values.Count()) return false;
+
+        value = Values[m_ValueIndex];
+        m_ValueIndex++;
+        return true;
+    }
+
+    bool ReadText(out string value)
+    {
+        if (m_TextIndex >= Text.Count()) return false;
+
+        value = Text[m_TextIndex];
+        m_TextIndex++;
+        return true;
+    }
+}
+
+// ============================================================
+// DELTA RESULT - Outcome of BankingClientAccountCache.ApplyDelta
+// ============================================================
+enum BankingDeltaResult
+{
+    APPLIED,
+    RESYNC,             // Revision gap or short delta - RequestFullSync
+    INCOMPATIBLE        // Other protocol version - a resync would not help
+}
+
+// ============================================================
+// SYNC STATE - Server side, what one client last received
+// ============================================================
+class BankingSyncState
+{
+    int Revision;
+    string PlayerName;
+    int Balance;
+    int MaxBalance;
+    int RemainingDailyWithdrawal;
+    int HistoryTotal;
+
+    void BankingSyncState()
+    {
+        Revision = 0;
+    }
+
+    // ============================================================
+    // BUILD DELTA - Changes since this state; updates the state
+    // ============================================================
+    // Pass isNew = true for a state that was never sent (full sync)
+    BankingAccountDelta BuildDelta(BankingAccount account, bool isNew, int maxHistory)
+    {
+        BankingAccountDelta delta = new BankingAccountDelta();
+        delta.BaseRevision = Revision;
+
+        int remainingDaily = account.GetRemainingDailyWithdrawal();
+
+        array<ref BankingTransaction> newHistory;
+
+        if (isNew)
+        {
+            delta.Fields = BankingDeltaField.FULL | BankingDeltaField.IDENTITY | BankingDeltaField.BALANCE | BankingDeltaField.MAX_BALANCE | BankingDeltaField.DAILY_WITHDRAWAL;
+        }
+        else
+        {
+            if (account.PlayerName != PlayerName)
+            {
+                delta.Fields |= BankingDeltaField.IDENTITY;
+            }
+
+            if (account.Balance != Balance)
+            {
+                delta.Fields |= BankingDeltaField.BALANCE;
+            }
+
+            if (account.MaxBalance != MaxBalance)
+            {
+                delta.Fields |= BankingDeltaField.MAX_BALANCE;
+            }
+
+            if (remainingDaily != RemainingDailyWithdrawal)
+            {
+                delta.Fields |= BankingDeltaField.DAILY_WITHDRAWAL;
+            }
+
+            // New transactions since last update (newest maxHistory only)
+            int newCount = account.HistoryTotal - HistoryTotal;
+            if (newCount > 0)
+            {
+                delta.Fields |= BankingDeltaField.HISTORY;
+                newCount = Math.Min(newCount, Math.Min(account.GetHistoryCount(), maxHistory));
+
+                newHistory = new array<ref BankingTransaction>;
+                for (int i = newCount - 1; i >= 0; i--)
+                {
+                    newHistory.Insert(account.GetHistoryEntry(i));
+                }
+            }
+        }
+
+        // Only the flagged fields, in BankingDeltaField order
+        if (delta.Has(BankingDeltaField.IDENTITY))
+        {
+            delta.WriteText(account.SteamID64);
+            delta.WriteText(account.PlayerName);
+        }
+
+        if (delta.Has(BankingDeltaField.BALANCE))
+        {
+            delta.WriteValue(account.Balance);
+        }
+
+        if (delta.Has(BankingDeltaField.MAX_BALANCE))
+        {
+            delta.WriteValue(account.MaxBalance);
+        }
+
+        if (delta.Has(BankingDeltaField.DAILY_WITHDRAWAL))
+        {
+            delta.WriteValue(remainingDaily);
+        }
+
+        if (delta.Has(BankingDeltaField.FULL) || delta.Has(BankingDeltaField.HISTORY))
+        {
+            delta.WriteValue(account.GetHistoryCount());
+        }
+
+        if (newHistory)
+        {
+            delta.NewHistory = BankingTransactionCodec.Encode(newHistory);
+        }
+
+        if (delta.Fields != 0)
+        {
+            Revision++;
+        }
+
+        delta.Revision = Revision;
+
+        PlayerName = account.PlayerName;
+        Balance = account.Balance;
+        MaxBalance = account.MaxBalance;
+        RemainingDailyWithdrawal = remainingDaily;
+        HistoryTotal = account.HistoryTotal;
+
+        return delta;
+    }
+}
+
+// ============================================================
+// CLIENT ACCOUNT CACHE - Client side, cached account + revision
+// ============================================================
+class BankingClientAccountCache
+{
+    static const int RECENT_HISTORY_MAX = 10;
+
+    protected ref BankingAccountSummary m_Account;
+    protected ref array<ref BankingTransaction> m_RecentHistory;  // Newest last
+    protected bool m_Incompatible;  // Server speaks another protocol (logged once)
+
+    private static ref BankingClientAccountCache m_Instance;
+
+    static BankingClientAccountCache GetInstance()
+    {
+        if (!m_Instance)
+        {
+            m_Instance = new BankingClientAccountCache();
+        }
+
+        return m_Instance;
+    }
+
+    void BankingClientAccountCache()
+    {
+        m_RecentHistory = new array<ref BankingTransaction>;
+    }
+
+    // ============================================================
+    // APPLY DELTA - Returns a BankingDeltaResult
+    // ============================================================
+    int ApplyDelta(BankingAccountDelta delta)
+    {
+        if (m_Incompatible)
+        {
+            return BankingDeltaResult.INCOMPATIBLE;
+        }
+
+        if (delta.Protocol != BANKING_SYNC_PROTOCOL)
+        {
+            m_Incompatible = true;
+            ModLogger.Error(BANKING_LOG, "Account sync protocol " + delta.Protocol.ToString() + " from server, client has " + BANKING_SYNC_PROTOCOL.ToString() + " - account updates disabled");
+            return BankingDeltaResult.INCOMPATIBLE;
+        }
+
+        if (delta.Has(BankingDeltaField.FULL))
+        {
+            m_Account = new BankingAccountSummary();
+            m_RecentHistory.Clear();
+        }
+        else if (!m_Account || m_Account.Revision != delta.BaseRevision)
+        {
+            return BankingDeltaResult.RESYNC;
+        }
+
+        // Read into locals first - a short delta must not half-update the cache
+        string steamID = m_Account.SteamID64;
+        string playerName = m_Account.PlayerName;
+        int balance = m_Account.Balance;
+        int maxBalance = m_Account.MaxBalance;
+        int remainingDaily = m_Account.RemainingDailyWithdrawal;
+        int historyCount = m_Account.HistoryCount;
+        bool valid = true;
+
+        if (delta.Has(BankingDeltaField.IDENTITY))
+        {
+            valid = valid && delta.ReadText(steamID) && delta.ReadText(playerName);
+        }
+
+        if (delta.Has(BankingDeltaField.BALANCE))
+        {
+            valid = valid && delta.ReadValue(balance);
+        }
+
+        if (delta.Has(BankingDeltaField.MAX_BALANCE))
+        {
+            valid = valid && delta.ReadValue(maxBalance);
+        }
+
+        if (delta.Has(BankingDeltaField.DAILY_WITHDRAWAL))
+        {
+            valid = valid && delta.ReadValue(remainingDaily);
+        }
+
+        if (delta.Has(BankingDeltaField.FULL) || delta.Has(BankingDeltaField.HISTORY))
+        {
+            valid = valid && delta.ReadValue(historyCount);
+        }
+
+        if (!valid)
+        {
+            m_Account = null;  // Forces RequestFullSync
+            return BankingDeltaResult.RESYNC;
+        }
+
+        m_Account.SteamID64 = steamID;
+        m_Account.PlayerName = playerName;
+        m_Account.Balance = balance;
+        m_Account.MaxBalance = maxBalance;
+        m_Account.RemainingDailyWithdrawal = remainingDaily;
+        m_Account.HistoryCount = historyCount;
+
+        if (delta.Has(BankingDeltaField.HISTORY))
+        {
+            array<ref BankingTransaction> newHistory = new array<ref BankingTransaction>;
+            BankingTransactionCodec.Decode(delta.NewHistory, newHistory);
+
+            foreach (BankingTransaction transaction : newHistory)
+            {
+                m_RecentHistory.Insert(transaction);
+            }
+
+            while (m_RecentHistory.Count() > RECENT_HISTORY_MAX)
+            {
+                m_RecentHistory.RemoveOrdered(0);
+            }
+        }
+
+        m_Account.Revision = delta.Revision;
+        return BankingDeltaResult.APPLIED;
+    }
+
+    BankingAccountSummary GetAccount()
+    {
+        return m_Account;
+    }
+
+    array<ref BankingTransaction> GetRecentHistory()
+    {
+        return m_RecentHistory;
+    }
+
+    void Clear()
+    {
+        m_Account = null;
+        m_RecentHistory.Clear();
+    }
+}
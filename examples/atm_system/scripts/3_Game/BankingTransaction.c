@@ -3,43 +3,80 @@
 // ============================================================
 // This class represents a single banking transaction
 // Used for transaction queue and logging
+//
+// Transactions are stored and sent in the compact binary form of
+// BankingTransactionCodec (see below). SerializeToJson is only for
+// admin tooling.
+
+// ============================================================
+// TRANSACTION ENUMS - Stored as small ints, never as strings
+// ============================================================
+enum BankingTransactionType
+{
+    UNKNOWN,        // Not set (or unreadable legacy entry)
+    DEPOSIT,
+    WITHDRAW,
+    TRANSFER,
+    CREDIT          // Transfer received while offline
+}
+
+enum BankingTransactionStatus
+{
+    PENDING,
+    COMPLETED,
+    FAILED
+}
+
+enum BankingFailReason
+{
+    NONE,
+    QUEUE_FULL,
+    OTHER
+}
 
 class BankingTransaction
 {
-    string TransactionID;         // Unique transaction ID
+    int IdHigh;                   // Server run the ID was issued in
+    int IdLow;                    // Sequence within that run
     string PlayerID;              // Steam64 ID of player
     string PlayerName;            // Player name (for logging)
     int Amount;                   // Transaction amount
-    string TransactionType;       // "deposit", "withdraw", "transfer"
+    int Type;                     // BankingTransactionType
     string TargetID;              // Target player ID (for transfers)
     string TargetName;            // Target player name (for transfers)
     int Fee;                      // Transaction fee (for transfers)
     int Timestamp;                // Unix timestamp
-    bool Processed;               // Whether transaction is completed
-    string Status;                // "pending", "completed", "failed"
+    int Status;                   // BankingTransactionStatus
+    int FailReason;               // BankingFailReason
 
     // ============================================================
     // CONSTRUCTOR - Create new transaction
     // ============================================================
-    void BankingTransaction(string playerID, string playerName, int amount, string type)
+    // Only typed transactions get an ID; decoders construct empty
+    // instances and fill them in.
+    void BankingTransaction(string playerID = "", string playerName = "", int amount = 0, int type = BankingTransactionType.UNKNOWN)
     {
-        TransactionID = GenerateTransactionID();
         PlayerID = playerID;
         PlayerName = playerName;
         Amount = amount;
-        TransactionType = type;
-        Timestamp = GetGame().GetTickTime();
-        Processed = false;
-        Status = "pending";
+        Type = type;
+        Status = BankingTransactionStatus.PENDING;
+        FailReason = BankingFailReason.NONE;
         Fee = 0;
+
+        if (type != BankingTransactionType.UNKNOWN)
+        {
+            BankingTransactionIds.Next(IdHigh, IdLow);
+            Timestamp = GetGame().GetTickTime();
+        }
     }
 
     // ============================================================
-    // GENERATE UNIQUE TRANSACTION ID
+    // GET ID STRING - 64-bit ID for logs ("TXN-<run>-<seq>")
     // ============================================================
-    string GenerateTransactionID()
+    string GetIdString()
     {
-        return "TXN_" + PlayerID + "_" + Timestamp.ToString() + "_" + Math.RandomInt(1000, 9999).ToString();
+        return "TXN-" + IdHigh.ToString() + "-" + IdLow.ToString();
     }
 
     // ============================================================
@@ -64,17 +101,72 @@ class BankingTransaction
     // ============================================================
     void MarkCompleted()
     {
-        Processed = true;
-        Status = "completed";
+        Status = BankingTransactionStatus.COMPLETED;
+        FailReason = BankingFailReason.NONE;
     }
 
     // ============================================================
     // MARK AS FAILED
     // ============================================================
-    void MarkFailed(string reason)
+    void MarkFailed(int reason)
+    {
+        Status = BankingTransactionStatus.FAILED;
+        FailReason = reason;
+    }
+
+    bool IsProcessed()
+    {
+        return Status != BankingTransactionStatus.PENDING;
+    }
+
+    // ============================================================
+    // NAMES - Lowercase names for logs and admin export
+    // ============================================================
+    static string GetTypeName(int type)
     {
-        Processed = true;
-        Status = "failed: " + reason;
+        switch (type)
+        {
+            case BankingTransactionType.DEPOSIT: return "deposit";
+            case BankingTransactionType.WITHDRAW: return "withdraw";
+            case BankingTransactionType.TRANSFER: return "transfer";
+            case BankingTransactionType.CREDIT: return "credit";
+        }
+
+        return "unknown";
+    }
+
+    static int ParseTypeName(string name)
+    {
+        switch (name)
+        {
+            case "deposit": return BankingTransactionType.DEPOSIT;
+            case "withdraw": return BankingTransactionType.WITHDRAW;
+            case "transfer": return BankingTransactionType.TRANSFER;
+            case "credit": return BankingTransactionType.CREDIT;
+        }
+
+        return BankingTransactionType.UNKNOWN;
+    }
+
+    string GetStatusName()
+    {
+        switch (Status)
+        {
+            case BankingTransactionStatus.PENDING:
+                return "pending";
+
+            case BankingTransactionStatus.COMPLETED:
+                return "completed";
+
+            case BankingTransactionStatus.FAILED:
+                if (FailReason == BankingFailReason.QUEUE_FULL)
+                {
+                    return "failed: queue full";
+                }
+                return "failed";
+        }
+
+        return "unknown";
     }
 
     // ============================================================
@@ -82,11 +174,14 @@ class BankingTransaction
     // ============================================================
     string GetSummary()
     {
-        string summary = "[" + TransactionType.ToUpper() + "] ";
+        string typeName = GetTypeName(Type);
+        typeName.ToUpper();
+
+        string summary = "[" + typeName + "] " + GetIdString() + " ";
         summary += PlayerName + " (" + PlayerID + ") ";
         summary += "Amount: " + Amount.ToString() + " ";
 
-        if (TransactionType == "transfer")
+        if (Type == BankingTransactionType.TRANSFER)
         {
             summary += "→ " + TargetName + " (" + TargetID + ") ";
             if (Fee > 0)
@@ -94,29 +189,357 @@ class BankingTransaction
                 summary += "(Fee: " + Fee.ToString() + ") ";
             }
         }
+        else if (Type == BankingTransactionType.CREDIT)
+        {
+            summary += "← " + TargetName + " (" + TargetID + ") ";
+        }
 
-        summary += "Status: " + Status;
+        summary += "Status: " + GetStatusName();
         return summary;
     }
 
     // ============================================================
-    // SERIALIZATION - Save to JSON
+    // SERIALIZATION - JSON export for admin tooling only
     // ============================================================
     static string SerializeToJson(BankingTransaction transaction)
     {
-        string json = "{";
-        json += "\"TransactionID\":\"" + transaction.TransactionID + "\",";
-        json += "\"PlayerID\":\"" + transaction.PlayerID + "\",";
-        json += "\"PlayerName\":\"" + transaction.PlayerName + "\",";
-        json += "\"Amount\":" + transaction.Amount.ToString() + ",";
-        json += "\"TransactionType\":\"" + transaction.TransactionType + "\",";
-        json += "\"TargetID\":\"" + transaction.TargetID + "\",";
-        json += "\"TargetName\":\"" + transaction.TargetName + "\",";
-        json += "\"Fee\":" + transaction.Fee.ToString() + ",";
-        json += "\"Timestamp\":" + transaction.Timestamp.ToString() + ",";
-        json += "\"Processed\":" + (transaction.Processed ? "true" : "false") + ",";
-        json += "\"Status\":\"" + transaction.Status + "\"";
-        json += "}";
+        BankingTransactionExport exported = new BankingTransactionExport(transaction);
+
+        string json;
+        JsonSerializer serializer = new JsonSerializer();
+        serializer.WriteToString(exported, false, json);
         return json;
     }
 }
+
+// ============================================================
+// TRANSACTION EXPORT - Readable JSON shape for admin tools
+// ============================================================
+class BankingTransactionExport
+{
+    string TransactionID;
+    string PlayerID;
+    string PlayerName;
+    int Amount;
+    string TransactionType;
+    string TargetID;
+    string TargetName;
+    int Fee;
+    int Timestamp;
+    string Status;
+
+    void BankingTransactionExport(BankingTransaction transaction = null)
+    {
+        if (!transaction)
+        {
+            return;
+        }
+
+        TransactionID = transaction.GetIdString();
+        PlayerID = transaction.PlayerID;
+        PlayerName = transaction.PlayerName;
+        Amount = transaction.Amount;
+        TransactionType = BankingTransaction.GetTypeName(transaction.Type);
+        TargetID = transaction.TargetID;
+        TargetName = transaction.TargetName;
+        Fee = transaction.Fee;
+        Timestamp = transaction.Timestamp;
+        Status = transaction.GetStatusName();
+    }
+}
+
+// ============================================================
+// LEGACY TRANSACTION - String-based layout before the codec
+// ============================================================
+// Read from old JSON account files and version 1 binary records,
+// then converted with ToTransaction.
+class BankingLegacyTransaction
+{
+    string TransactionID;
+    string PlayerID;
+    string PlayerName;
+    int Amount;
+    string TransactionType;
+    string TargetID;
+    string TargetName;
+    int Fee;
+    int Timestamp;
+    bool Processed;
+    string Status;
+
+    bool ReadBinary(Serializer ctx)
+    {
+        if (!ctx.Read(TransactionID)) return false;
+        if (!ctx.Read(PlayerID)) return false;
+        if (!ctx.Read(PlayerName)) return false;
+        if (!ctx.Read(Amount)) return false;
+        if (!ctx.Read(TransactionType)) return false;
+        if (!ctx.Read(TargetID)) return false;
+        if (!ctx.Read(TargetName)) return false;
+        if (!ctx.Read(Fee)) return false;
+        if (!ctx.Read(Timestamp)) return false;
+        if (!ctx.Read(Processed)) return false;
+        if (!ctx.Read(Status)) return false;
+
+        return true;
+    }
+
+    // Legacy IDs were random strings - converted entries get ID 0-0
+    BankingTransaction ToTransaction()
+    {
+        BankingTransaction transaction = new BankingTransaction();
+        transaction.PlayerID = PlayerID;
+        transaction.PlayerName = PlayerName;
+        transaction.Amount = Amount;
+        transaction.Type = BankingTransaction.ParseTypeName(TransactionType);
+        transaction.TargetID = TargetID;
+        transaction.TargetName = TargetName;
+        transaction.Fee = Fee;
+        transaction.Timestamp = Timestamp;
+
+        if (Status == "completed")
+        {
+            transaction.MarkCompleted();
+        }
+        else if (Status.IndexOf("failed") == 0)
+        {
+            transaction.MarkFailed(BankingFailReason.OTHER);
+        }
+
+        return transaction;
+    }
+}
+
+// ============================================================
+// LEGACY ACCOUNT HISTORY - History part of an old JSON account
+// ============================================================
+class BankingLegacyAccountHistory
+{
+    ref array<ref BankingLegacyTransaction> TransactionHistory;
+}
+
+// ============================================================
+// TRANSACTION IDS - Monotonic 64-bit IDs (run, sequence)
+// ============================================================
+// The high half is a run number bumped once per server start and
+// persisted, the low half counts up within the run. IDs therefore
+// never repeat across restarts without writing per transaction.
+class BankingTransactionIdState
+{
+    int LastRun;
+}
+
+class BankingTransactionIds
+{
+    static const string STATE_FILE = "$profile:Banking/transaction_ids.json";
+
+    protected static int s_Run = -1;
+    protected static int s_Sequence;
+
+    static void Next(out int high, out int low)
+    {
+        if (s_Run < 0 || s_Sequence == int.MAX)
+        {
+            StartRun();
+        }
+
+        s_Sequence++;
+        high = s_Run;
+        low = s_Sequence;
+    }
+
+    protected static void StartRun()
+    {
+        BankingTransactionIdState state = new BankingTransactionIdState();
+        if (FileExist(STATE_FILE))
+        {
+            JsonFileLoader<BankingTransactionIdState>.JsonLoadFile(STATE_FILE, state);
+        }
+
+        state.LastRun++;
+
+        if (!FileExist(BankingAccountStore.BANKING_DIR))
+        {
+            MakeDirectory(BankingAccountStore.BANKING_DIR);
+        }
+
+        JsonFileLoader<BankingTransactionIdState>.JsonSaveFile(STATE_FILE, state);
+
+        s_Run = state.LastRun;
+        s_Sequence = 0;
+    }
+}
+
+// ============================================================
+// TRANSACTION BATCH - Encoded list of transactions
+// ============================================================
+// Strings holds every distinct player ID and name once; Words holds
+// the byte stream (see BankingBinary.c). Sent as an RPC parameter
+// and written into binary account records.
+class BankingTransactionBatch
+{
+    int Count;
+    int ByteCount;
+    ref array<string> Strings;
+    ref array<int> Words;
+
+    void BankingTransactionBatch()
+    {
+        Count = 0;
+        ByteCount = 0;
+        Strings = new array<string>;
+        Words = new array<int>;
+    }
+
+    void Write(Serializer ctx)
+    {
+        ctx.Write(Count);
+        ctx.Write(ByteCount);
+
+        ctx.Write(Strings.Count());
+        foreach (string value : Strings)
+        {
+            ctx.Write(value);
+        }
+
+        ctx.Write(Words.Count());
+        foreach (int word : Words)
+        {
+            ctx.Write(word);
+        }
+    }
+
+    bool Read(Serializer ctx)
+    {
+        if (!ctx.Read(Count)) return false;
+        if (!ctx.Read(ByteCount)) return false;
+
+        int stringCount;
+        if (!ctx.Read(stringCount)) return false;
+
+        Strings.Clear();
+        for (int i = 0; i < stringCount; i++)
+        {
+            string value;
+            if (!ctx.Read(value)) return false;
+            Strings.Insert(value);
+        }
+
+        int wordCount;
+        if (!ctx.Read(wordCount)) return false;
+
+        Words.Clear();
+        for (int j = 0; j < wordCount; j++)
+        {
+            int word;
+            if (!ctx.Read(word)) return false;
+            Words.Insert(word);
+        }
+
+        return true;
+    }
+}
+
+// ============================================================
+// TRANSACTION CODEC - Transactions <-> BankingTransactionBatch
+// ============================================================
+// Per transaction:
+//   byte    Type | Status << 3 | FailReason << 5
+//   varuint IdHigh, IdLow
+//   varuint PlayerID, PlayerName, TargetID, TargetName (string table index)
+//   varint  Amount
+//   varuint Fee
+//   varint  Timestamp - previous Timestamp
+class BankingTransactionCodec
+{
+    static BankingTransactionBatch Encode(array<ref BankingTransaction> transactions)
+    {
+        BankingTransactionBatch batch = new BankingTransactionBatch();
+        BankingStringTable strings = new BankingStringTable();
+        BankingByteWriter writer = new BankingByteWriter();
+        int previousTime = 0;
+
+        foreach (BankingTransaction transaction : transactions)
+        {
+            writer.WriteByte((transaction.Type & 0x07) | ((transaction.Status & 0x03) << 3) | ((transaction.FailReason & 0x07) << 5));
+            writer.WriteVarUInt(transaction.IdHigh);
+            writer.WriteVarUInt(transaction.IdLow);
+            writer.WriteVarUInt(strings.Intern(transaction.PlayerID));
+            writer.WriteVarUInt(strings.Intern(transaction.PlayerName));
+            writer.WriteVarUInt(strings.Intern(transaction.TargetID));
+            writer.WriteVarUInt(strings.Intern(transaction.TargetName));
+            writer.WriteVarInt(transaction.Amount);
+            writer.WriteVarUInt(transaction.Fee);
+            writer.WriteVarInt(transaction.Timestamp - previousTime);
+            previousTime = transaction.Timestamp;
+        }
+
+        batch.Count = transactions.Count();
+        batch.ByteCount = writer.GetByteCount();
+        batch.Words = writer.Finish();
+        batch.Strings = strings.Strings;
+        return batch;
+    }
+
+    // Appends decoded transactions to result; false if the batch is malformed
+    static bool Decode(BankingTransactionBatch batch, array<ref BankingTransaction> result)
+    {
+        if (!batch || !batch.Words || !batch.Strings)
+        {
+            return false;
+        }
+
+        BankingByteReader reader = new BankingByteReader(batch.Words, batch.ByteCount);
+        int previousTime = 0;
+
+        for (int i = 0; i < batch.Count; i++)
+        {
+            int header = reader.ReadByte();
+            if (header < 0)
+            {
+                return false;
+            }
+
+            BankingTransaction transaction = new BankingTransaction();
+            transaction.Type = header & 0x07;
+            transaction.Status = (header >> 3) & 0x03;
+            transaction.FailReason = (header >> 5) & 0x07;
+
+            int idHigh, idLow, playerID, playerName, targetID, targetName, amount, fee, timeDelta;
+            if (!reader.ReadVarUInt(idHigh)) return false;
+            if (!reader.ReadVarUInt(idLow)) return false;
+            if (!reader.ReadVarUInt(playerID)) return false;
+            if (!reader.ReadVarUInt(playerName)) return false;
+            if (!reader.ReadVarUInt(targetID)) return false;
+            if (!reader.ReadVarUInt(targetName)) return false;
+            if (!reader.ReadVarInt(amount)) return false;
+            if (!reader.ReadVarUInt(fee)) return false;
+            if (!reader.ReadVarInt(timeDelta)) return false;
+
+            transaction.IdHigh = idHigh;
+            transaction.IdLow = idLow;
+            transaction.PlayerID = GetString(batch, playerID);
+            transaction.PlayerName = GetString(batch, playerName);
+            transaction.TargetID = GetString(batch, targetID);
+            transaction.TargetName = GetString(batch, targetName);
+            transaction.Amount = amount;
+            transaction.Fee = fee;
+            transaction.Timestamp = previousTime + timeDelta;
+            previousTime = transaction.Timestamp;
+
+            result.Insert(transaction);
+        }
+
+        return true;
+    }
+
+    protected static string GetString(BankingTransactionBatch batch, int index)
+    {
+        if (index < 0 || index >= batch.Strings.Count())
+        {
+            return "";
+        }
+
+        return batch.Strings[index];
+    }
+}
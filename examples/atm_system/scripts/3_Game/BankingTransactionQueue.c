@@ -0,0 +1,177 @@
+// ============================================================
+// BANKING TRANSACTION QUEUE - Fixed-capacity FIFO ring buffer
+// ============================================================
+// O(1) enqueue and dequeue (no array shifting).
+// Tracks queue depth and how long transactions waited.
+
+class BankingTransactionQueue
+{
+    protected ref array<ref BankingTransaction> m_Items;
+    protected ref array<int> m_EnqueueTimes;    // GetGame().GetTime() at enqueue (ms)
+    protected int m_Head;                       // Next item to dequeue
+    protected int m_Count;
+    protected int m_Capacity;
+
+    // Metrics
+    protected int m_MaxDepth;
+    protected int m_TotalEnqueued;
+    protected int m_TotalDequeued;
+    protected int m_TotalRejected;
+    protected int m_TotalWaitMs;
+    protected int m_MaxWaitMs;
+    protected int m_LastWaitMs;
+
+    // ============================================================
+    // CONSTRUCTOR
+    // ============================================================
+    void BankingTransactionQueue(int capacity)
+    {
+        m_Capacity = Math.Max(capacity, 1);
+        m_Items = new array<ref BankingTransaction>;
+        m_EnqueueTimes = new array<int>;
+        m_Items.Resize(m_Capacity);
+        m_EnqueueTimes.Resize(m_Capacity);
+        m_Head = 0;
+        m_Count = 0;
+
+        ResetStats();
+    }
+
+    // ============================================================
+    // ENQUEUE - Returns false when the queue is full
+    // ============================================================
+    bool Enqueue(BankingTransaction transaction)
+    {
+        if (m_Count >= m_Capacity)
+        {
+            m_TotalRejected++;
+            return false;
+        }
+
+        int tail = (m_Head + m_Count) % m_Capacity;
+        m_Items[tail] = transaction;
+        m_EnqueueTimes[tail] = GetGame().GetTime();
+        m_Count++;
+        m_TotalEnqueued++;
+
+        if (m_Count > m_MaxDepth)
+        {
+            m_MaxDepth = m_Count;
+        }
+
+        return true;
+    }
+
+    // ============================================================
+    // DEQUEUE - Oldest transaction, or null when empty
+    // ============================================================
+    BankingTransaction Dequeue()
+    {
+        if (m_Count == 0)
+        {
+            return null;
+        }
+
+        BankingTransaction transaction = m_Items[m_Head];
+        int waitMs = GetGame().GetTime() - m_EnqueueTimes[m_Head];
+
+        m_Items[m_Head] = null;
+        m_Head = (m_Head + 1) % m_Capacity;
+        m_Count--;
+
+        m_TotalDequeued++;
+        m_TotalWaitMs += waitMs;
+        m_LastWaitMs = waitMs;
+        if (waitMs > m_MaxWaitMs)
+        {
+            m_MaxWaitMs = waitMs;
+        }
+
+        return transaction;
+    }
+
+    // ============================================================
+    // STATE
+    // ============================================================
+    int Count()
+    {
+        return m_Count;
+    }
+
+    int GetCapacity()
+    {
+        return m_Capacity;
+    }
+
+    bool IsEmpty()
+    {
+        return m_Count == 0;
+    }
+
+    bool IsFull()
+    {
+        return m_Count >= m_Capacity;
+    }
+
+    // Fill level 0..1 - callers can slow down before the queue is full
+    float GetLoad()
+    {
+        float count = m_Count;
+        return count / m_Capacity;
+    }
+
+    // ============================================================
+    // METRICS
+    // ============================================================
+    int GetMaxDepth()
+    {
+        return m_MaxDepth;
+    }
+
+    int GetTotalEnqueued()
+    {
+        return m_TotalEnqueued;
+    }
+
+    int GetTotalDequeued()
+    {
+        return m_TotalDequeued;
+    }
+
+    int GetTotalRejected()
+    {
+        return m_TotalRejected;
+    }
+
+    int GetMaxWaitMs()
+    {
+        return m_MaxWaitMs;
+    }
+
+    int GetLastWaitMs()
+    {
+        return m_LastWaitMs;
+    }
+
+    float GetAverageWaitMs()
+    {
+        if (m_TotalDequeued == 0)
+        {
+            return 0;
+        }
+
+        float total = m_TotalWaitMs;
+        return total / m_TotalDequeued;
+    }
+
+    void ResetStats()
+    {
+        m_MaxDepth = m_Count;
+        m_TotalEnqueued = 0;
+        m_TotalDequeued = 0;
+        m_TotalRejected = 0;
+        m_TotalWaitMs = 0;
+        m_MaxWaitMs = 0;
+        m_LastWaitMs = 0;
+    }
+}
@@ -6,6 +6,8 @@
 
 class ActionOpenATM: ActionInteractBase
 {
+    static const float ATM_USE_RANGE = 10.0;  // Max distance to the ATM (meters)
+
     // ============================================================
     // CONSTRUCTOR - Initialize action properties
     // ============================================================
@@ -21,7 +23,7 @@ class ActionOpenATM: ActionInteractBase
     // ============================================================
     override void CreateConditionComponents()
     {
-        m_ConditionTarget = new CCTObject(10);  // 10-meter range
+        m_ConditionTarget = new CCTObject(ATM_USE_RANGE);
         m_ConditionItem = new CCINone;          // No item required in hands
     }
 
@@ -58,6 +60,21 @@ class ActionOpenATM: ActionInteractBase
             return false;  // Not an ATM
         }
 
+        // Registered ATMs must be online and actually near the player
+        ATMEntity atm = ATMEntity.Cast(building);
+        if (atm)
+        {
+            if (!atm.IsOnline())
+            {
+                return false;  // ATM offline
+            }
+
+            if (vector.DistanceSq(player.GetPosition(), atm.GetPosition()) > ATM_USE_RANGE * ATM_USE_RANGE)
+            {
+                return false;  // Player is not at this ATM
+            }
+        }
+
         // Check if credit card is required
         if (GetBankingConfig().RequireCreditCard)
         {
@@ -102,9 +119,11 @@ class ActionOpenATM: ActionInteractBase
 
         PlayerBase player = action_data.m_Player;
 
-        if (GetBankingConfig().BankingLogs)
+#ifdef DEVELOPER
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.DEBUG))
         {
-            Print("[ATM System] Player " + player.GetIdentity().GetName() + " opened bank menu");
+            ModLogger.Debug(BANKING_LOG, "Player " + player.GetIdentity().GetName() + " opened bank menu");
         }
+#endif
     }
 }
@@ -2,7 +2,7 @@
 // ATM ENTITY - Extended ATM object class
 // ============================================================
 // This class extends the basic ATM building with additional functionality
-// Currently serves as a placeholder for future ATM features
+// ATMs register themselves in ATMRegistry (spatial grid) once placed
 
 class ATMEntity: BuildingBase
 {
@@ -11,6 +11,8 @@ class ATMEntity: BuildingBase
     // ============================================================
     protected bool m_IsOnline;  // Is ATM operational
     protected float m_CashReserve;  // Physical cash reserve (optional feature)
+    protected bool m_IsRegistered;  // Stored in ATMRegistry
+    protected int m_RegistryCell;   // ATMRegistry cell key
 
     // ============================================================
     // CONSTRUCTOR - Initialize ATM
@@ -19,9 +21,10 @@ class ATMEntity: BuildingBase
     {
         m_IsOnline = true;
         m_CashReserve = 100000;  // 100k cash reserve
+        m_IsRegistered = false;
 
-        // Register ATM with BankingManager (optional)
-        RegisterATM();
+        // Register once the ATM has its final position
+        GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).Call(RegisterATM);
     }
 
     // ============================================================
@@ -29,30 +32,55 @@ class ATMEntity: BuildingBase
     // ============================================================
     void ~ATMEntity()
     {
-        // Unregister ATM (optional)
+        // Unregister ATM
+        if (GetGame())
+        {
+            GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).Remove(RegisterATM);
+        }
+
         UnregisterATM();
     }
 
     // ============================================================
-    // REGISTER ATM - Register with banking system
+    // REGISTER ATM - Add to the spatial ATM registry
     // ============================================================
     void RegisterATM()
     {
-        // Placeholder for future features
-        // Could be used for:
-        // - ATM network tracking
-        // - Location-based services
-        // - Cash reserve management
+        if (m_IsRegistered)
+        {
+            return;
+        }
+
+        m_RegistryCell = ATMRegistry.GetInstance().Register(this);
+        m_IsRegistered = true;
 
-        Print("[ATM System] ATM registered at position: " + GetPosition().ToString());
+#ifdef DEVELOPER
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug(BANKING_LOG, "ATM registered at position: " + GetPosition().ToString());
+        }
+#endif
     }
 
     // ============================================================
-    // UNREGISTER ATM - Unregister from banking system
+    // UNREGISTER ATM - Remove from the spatial ATM registry
     // ============================================================
     void UnregisterATM()
     {
-        Print("[ATM System] ATM unregistered");
+        if (!m_IsRegistered)
+        {
+            return;
+        }
+
+        ATMRegistry.GetInstance().Unregister(this, m_RegistryCell);
+        m_IsRegistered = false;
+
+#ifdef DEVELOPER
+        if (ModLogger.IsEnabled(BANKING_LOG, ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug(BANKING_LOG, "ATM unregistered");
+        }
+#endif
     }
 
     // ============================================================
@@ -98,22 +126,12 @@ class ATMEntity: BuildingBase
     // ============================================================
     void NotifyNearbyPlayers(string message)
     {
-        array<Man> players = new array<Man>;
-        GetGame().GetPlayers(players);
+        array<PlayerBase> players = new array<PlayerBase>;
+        ATMRegistry.GetInstance().GetPlayersInRadius(GetPosition(), 10, players);  // 10-meter radius
 
-        foreach (Man man : players)
+        foreach (PlayerBase player : players)
         {
-            PlayerBase player = PlayerBase.Cast(man);
-
-            if (player)
-            {
-                float distance = vector.Distance(player.GetPosition(), GetPosition());
-
-                if (distance <= 10)  // 10-meter radius
-                {
-                    NotificationSystem.Notify(player, message);
-                }
-            }
+            NotificationSystem.Notify(player, message);
         }
     }
 
@@ -126,7 +144,7 @@ class ATMEntity: BuildingBase
 
         // ATM cannot be damaged (defined in config.cpp)
         // This is just a safety check
-        Print("[ATM System] ATM hit by damage source: " + source.ToString());
+        ModLogger.Info(BANKING_LOG, "ATM hit by damage source: " + source.ToString());
     }
 
     // ============================================================
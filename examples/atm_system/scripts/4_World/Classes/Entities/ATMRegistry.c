@@ -0,0 +1,302 @@
+// ============================================================
+// ATM REGISTRY - Spatial index of ATMs and nearby players
+// ============================================================
+// ATMs are bucketed into a uniform grid of CELL_SIZE meter cells,
+// so "ATMs within R" and "nearest ATM" only look at the cells the
+// query touches instead of every ATM on the map.
+//
+// Players move, so they are bucketed into a second grid that is
+// rebuilt from PlayerRegistry at most every PLAYER_GRID_REFRESH_MS,
+// and only when a player query actually needs it.
+
+class ATMRegistry
+{
+    static const float CELL_SIZE = 64.0;                // Grid cell edge (meters)
+    static const int PLAYER_GRID_REFRESH_MS = 1000;     // Max age of the player grid
+    static const float PLAYER_MOVE_MARGIN = 10.0;       // Distance a player may move between refreshes
+
+    protected ref map<int, ref array<ATMEntity>> m_ATMCells;
+    protected ref array<ATMEntity> m_ATMs;
+
+    protected ref map<int, ref array<PlayerBase>> m_PlayerCells;
+    protected int m_PlayerGridTime;
+    protected bool m_PlayerGridBuilt;
+
+    private static ref ATMRegistry m_Instance;
+
+    // ============================================================
+    // GET INSTANCE - Singleton pattern
+    // ============================================================
+    static ATMRegistry GetInstance()
+    {
+        if (!m_Instance)
+        {
+            m_Instance = new ATMRegistry();
+        }
+
+        return m_Instance;
+    }
+
+    void ATMRegistry()
+    {
+        m_ATMCells = new map<int, ref array<ATMEntity>>;
+        m_ATMs = new array<ATMEntity>;
+        m_PlayerCells = new map<int, ref array<PlayerBase>>;
+        m_PlayerGridBuilt = false;
+    }
+
+    // ============================================================
+    // REGISTER / UNREGISTER - Returns the cell key the ATM is stored in
+    // ============================================================
+    int Register(ATMEntity atm)
+    {
+        int key = GetCellKey(atm.GetPosition());
+
+        array<ATMEntity> cell = m_ATMCells.Get(key);
+        if (!cell)
+        {
+            cell = new array<ATMEntity>;
+            m_ATMCells.Set(key, cell);
+        }
+
+        if (cell.Find(atm) < 0)
+        {
+            cell.Insert(atm);
+            m_ATMs.Insert(atm);
+        }
+
+        return key;
+    }
+
+    void Unregister(ATMEntity atm, int key)
+    {
+        array<ATMEntity> cell = m_ATMCells.Get(key);
+        if (cell)
+        {
+            int index = cell.Find(atm);
+            if (index >= 0)
+            {
+                cell.Remove(index);
+            }
+
+            if (cell.Count() == 0)
+            {
+                m_ATMCells.Remove(key);
+            }
+        }
+
+        int listIndex = m_ATMs.Find(atm);
+        if (listIndex >= 0)
+        {
+            m_ATMs.Remove(listIndex);
+        }
+    }
+
+    // ============================================================
+    // GET ATMS IN RADIUS - ATMs within radius of position
+    // ============================================================
+    void GetATMsInRadius(vector position, float radius, array<ATMEntity> result)
+    {
+        float radiusSq = radius * radius;
+        int minX = GetCellCoord(position[0] - radius);
+        int maxX = GetCellCoord(position[0] + radius);
+        int minZ = GetCellCoord(position[2] - radius);
+        int maxZ = GetCellCoord(position[2] + radius);
+
+        for (int x = minX; x <= maxX; x++)
+        {
+            for (int z = minZ; z <= maxZ; z++)
+            {
+                array<ATMEntity> cell = m_ATMCells.Get(MakeKey(x, z));
+                if (!cell)
+                {
+                    continue;
+                }
+
+                foreach (ATMEntity atm : cell)
+                {
+                    if (atm && vector.DistanceSq(atm.GetPosition(), position) <= radiusSq)
+                    {
+                        result.Insert(atm);
+                    }
+                }
+            }
+        }
+    }
+
+    // ============================================================
+    // FIND NEAREST - Closest ATM within maxDistance (null = none)
+    // ============================================================
+    // Searches rings of cells outward and stops once no closer ATM
+    // can exist in the next ring
+    ATMEntity FindNearest(vector position, float maxDistance, bool onlineOnly = true)
+    {
+        int centerX = GetCellCoord(position[0]);
+        int centerZ = GetCellCoord(position[2]);
+        int maxRing = Math.Ceil(maxDistance / CELL_SIZE);
+
+        ATMEntity best;
+        float bestDistSq = maxDistance * maxDistance;
+
+        for (int ring = 0; ring <= maxRing; ring++)
+        {
+            // Every ATM in this ring is at least (ring - 1) cells away
+            float ringMin = (ring - 1) * CELL_SIZE;
+            if (best && ringMin > 0 && ringMin * ringMin > bestDistSq)
+            {
+                break;
+            }
+
+            if (ring == 0)
+            {
+                best = NearestInCell(centerX, centerZ, position, onlineOnly, best, bestDistSq);
+                continue;
+            }
+
+            // Only the 8 * ring border cells - inner cells were done
+            for (int i = -ring; i <= ring; i++)
+            {
+                // Top and bottom rows (corners included)
+                best = NearestInCell(centerX + i, centerZ - ring, position, onlineOnly, best, bestDistSq);
+                best = NearestInCell(centerX + i, centerZ + ring, position, onlineOnly, best, bestDistSq);
+
+                // Left and right columns (corners excluded)
+                if (i > -ring && i < ring)
+                {
+                    best = NearestInCell(centerX - ring, centerZ + i, position, onlineOnly, best, bestDistSq);
+                    best = NearestInCell(centerX + ring, centerZ + i, position, onlineOnly, best, bestDistSq);
+                }
+            }
+        }
+
+        return best;
+    }
+
+    // Closest ATM of one cell if nearer than best (bestDistSq is updated)
+    protected ATMEntity NearestInCell(int x, int z, vector position, bool onlineOnly, ATMEntity best, inout float bestDistSq)
+    {
+        array<ATMEntity> cell = m_ATMCells.Get(MakeKey(x, z));
+        if (!cell)
+        {
+            return best;
+        }
+
+        foreach (ATMEntity atm : cell)
+        {
+            if (!atm || (onlineOnly && !atm.IsOnline()))
+            {
+                continue;
+            }
+
+            float distSq = vector.DistanceSq(atm.GetPosition(), position);
+            if (distSq <= bestDistSq)
+            {
+                best = atm;
+                bestDistSq = distSq;
+            }
+        }
+
+        return best;
+    }
+
+    // ============================================================
+    // GET PLAYERS IN RADIUS - Online players near a position
+    // ============================================================
+    // Uses the player grid (up to PLAYER_GRID_REFRESH_MS old); the
+    // final distance check uses current positions
+    void GetPlayersInRadius(vector position, float radius, array<PlayerBase> result)
+    {
+        RefreshPlayerGrid();
+
+        float radiusSq = radius * radius;
+        float searchRadius = radius + PLAYER_MOVE_MARGIN;
+        int minX = GetCellCoord(position[0] - searchRadius);
+        int maxX = GetCellCoord(position[0] + searchRadius);
+        int minZ = GetCellCoord(position[2] - searchRadius);
+        int maxZ = GetCellCoord(position[2] + searchRadius);
+
+        for (int x = minX; x <= maxX; x++)
+        {
+            for (int z = minZ; z <= maxZ; z++)
+            {
+                array<PlayerBase> cell = m_PlayerCells.Get(MakeKey(x, z));
+                if (!cell)
+                {
+                    continue;
+                }
+
+                foreach (PlayerBase player : cell)
+                {
+                    if (player && vector.DistanceSq(player.GetPosition(), position) <= radiusSq)
+                    {
+                        result.Insert(player);
+                    }
+                }
+            }
+        }
+    }
+
+    // ============================================================
+    // GET ALL - Every registered ATM (for map markers)
+    // ============================================================
+    array<ATMEntity> GetAll()
+    {
+        return m_ATMs;
+    }
+
+    int Count()
+    {
+        return m_ATMs.Count();
+    }
+
+    // ============================================================
+    // HELPERS
+    // ============================================================
+    protected void RefreshPlayerGrid()
+    {
+        int now = GetGame().GetTime();
+        if (m_PlayerGridBuilt && now - m_PlayerGridTime < PLAYER_GRID_REFRESH_MS)
+        {
+            return;
+        }
+
+        m_PlayerCells.Clear();
+
+        foreach (PlayerBase player : PlayerRegistry.GetInstance().GetPlayers())
+        {
+            if (!player)
+            {
+                continue;
+            }
+
+            int key = GetCellKey(player.GetPosition());
+            array<PlayerBase> cell = m_PlayerCells.Get(key);
+            if (!cell)
+            {
+                cell = new array<PlayerBase>;
+                m_PlayerCells.Set(key, cell);
+            }
+
+            cell.Insert(player);
+        }
+
+        m_PlayerGridTime = now;
+        m_PlayerGridBuilt = true;
+    }
+
+    static int GetCellCoord(float value)
+    {
+        return Math.Floor(value / CELL_SIZE);
+    }
+
+    static int GetCellKey(vector position)
+    {
+        return MakeKey(GetCellCoord(position[0]), GetCellCoord(position[2]));
+    }
+
+    // 16 bits per axis - enough for maps up to ~4000 km at 64 m cells
+    static int MakeKey(int x, int z)
+    {
+        return ((x & 0xFFFF) << 16) | (z & 0xFFFF);
+    }
+}
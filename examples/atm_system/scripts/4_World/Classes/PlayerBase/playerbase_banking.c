@@ -0,0 +1,34 @@
+// ============================================================
+// PLAYERBASE BANKING - Connect/disconnect hooks
+// ============================================================
+// Pins the account of online players in the BankingManager cache
+// so it is never evicted while the player is on the server
+
+modded class PlayerBase
+{
+    // ============================================================
+    // ON CONNECT - Pin account in cache
+    // ============================================================
+    override void OnConnect()
+    {
+        super.OnConnect();
+
+        if (GetGame().IsServer() && GetIdentity())
+        {
+            BankingManager.GetInstance().OnPlayerConnected(GetIdentity().GetPlainId());
+        }
+    }
+
+    // ============================================================
+    // ON DISCONNECT - Unpin account (may be evicted afterwards)
+    // ============================================================
+    override void OnDisconnect()
+    {
+        super.OnDisconnect();
+
+        if (GetGame().IsServer() && GetIdentity())
+        {
+            BankingManager.GetInstance().OnPlayerDisconnected(GetIdentity().GetPlainId());
+        }
+    }
+}
@@ -21,9 +21,16 @@ class BankingMenu: UIScriptedMenu
     protected ButtonWidget m_TransferButton;
     protected EditBoxWidget m_AmountEditBox;
     protected EditBoxWidget m_TargetIDEditBox;
+    protected TextListboxWidget m_HistoryList;
 
-    // Current player account
-    protected ref BankingAccount m_Account;
+    // Current player account (summary, no history)
+    protected ref BankingAccountSummary m_Account;
+
+    // Currently displayed history page (loaded on demand)
+    static const int HISTORY_PAGE_SIZE = 10;
+    protected int m_HistoryPage;
+    protected int m_HistoryTotal;
+    protected ref array<ref BankingTransaction> m_HistoryEntries;
 
     // ============================================================
     // CONSTRUCTOR
@@ -31,6 +38,9 @@ class BankingMenu: UIScriptedMenu
     void BankingMenu()
     {
         m_Account = null;
+        m_HistoryPage = 0;
+        m_HistoryTotal = 0;
+        m_HistoryEntries = new array<ref BankingTransaction>;
     }
 
     // ============================================================
@@ -44,20 +54,87 @@ class BankingMenu: UIScriptedMenu
         // Get widgets from layout
         // m_BalanceText = TextWidget.Cast(layout.FindWidget("balance_text"));
         // m_DepositButton = ButtonWidget.Cast(layout.FindWidget("deposit_button"));
+        // m_HistoryList = TextListboxWidget.Cast(layout.FindWidget("history_list"));
         // etc.
 
-        Print("[ATM System] BankingMenu initialized");
+        // Load first history page
+        RequestHistoryPage(0);
+
+        ModLogger.Info(BANKING_LOG, "BankingMenu initialized");
     }
 
     // ============================================================
     // SET ACCOUNT - Set current account for display
     // ============================================================
-    void SetAccount(BankingAccount account)
+    void SetAccount(BankingAccountSummary account)
     {
         m_Account = account;
         UpdateDisplay();
     }
 
+    // ============================================================
+    // REQUEST HISTORY PAGE - Ask server for one page (0 = newest)
+    // ============================================================
+    void RequestHistoryPage(int page)
+    {
+        GetRPCManager().SendRPC("ATM_System", "RequestHistory",
+            new Param2<int, int>(page, HISTORY_PAGE_SIZE), true);
+    }
+
+    // ============================================================
+    // SET HISTORY PAGE - Server response to RequestHistoryPage
+    // ============================================================
+    void SetHistoryPage(int page, int total, array<ref BankingTransaction> entries)
+    {
+        m_HistoryPage = page;
+        m_HistoryTotal = total;
+        m_HistoryEntries = entries;
+        UpdateHistoryDisplay();
+    }
+
+    // ============================================================
+    // HISTORY PAGING - Next/previous page buttons
+    // ============================================================
+    bool OnHistoryNextClick()
+    {
+        if ((m_HistoryPage + 1) * HISTORY_PAGE_SIZE >= m_HistoryTotal)
+        {
+            return false;  // Already on last page
+        }
+
+        RequestHistoryPage(m_HistoryPage + 1);
+        return true;
+    }
+
+    bool OnHistoryPrevClick()
+    {
+        if (m_HistoryPage == 0)
+        {
+            return false;
+        }
+
+        RequestHistoryPage(m_HistoryPage - 1);
+        return true;
+    }
+
+    // ============================================================
+    // UPDATE HISTORY DISPLAY - Fill history list with current page
+    // ============================================================
+    void UpdateHistoryDisplay()
+    {
+        if (!m_HistoryList)
+        {
+            return;
+        }
+
+        m_HistoryList.ClearItems();
+
+        foreach (BankingTransaction transaction : m_HistoryEntries)
+        {
+            m_HistoryList.AddItem(transaction.GetSummary(), null, 0);
+        }
+    }
+
     // ============================================================
     // UPDATE DISPLAY - Update UI with current account data
     // ============================================================
@@ -72,7 +149,7 @@ class BankingMenu: UIScriptedMenu
         // m_BalanceText.SetText("Balance: " + m_Account.Balance.ToString());
 
         // Update daily withdrawal limit
-        // int remaining = m_Account.GetRemainingDailyWithdrawal();
+        // int remaining = m_Account.RemainingDailyWithdrawal;
         // if (remaining >= 0)
         // {
         //     m_DailyLimitText.SetText("Daily Withdrawal Limit: " + remaining.ToString() + " / " + GetBankingConfig().DailyWithdrawalLimit.ToString());
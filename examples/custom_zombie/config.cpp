@@ -5,7 +5,7 @@ class CfgPatches
         units[] = {"CustomBandit"};
         weapons[] = {};
         requiredVersion = 0.1;
-        requiredAddons[] = {"DZ_Data"};
+        requiredAddons[] = {"DZ_Data", "PlayerRegistry"};
     };
 };
 
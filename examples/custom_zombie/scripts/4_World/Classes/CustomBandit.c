@@ -95,13 +95,11 @@ class CustomBandit extends InfectedBanditBase
 
     PlayerBase FindNearestPlayer()
     {
-        array<PlayerBase> players = new array<PlayerBase>;
-        GetGame().GetPlayers(players);
-
         PlayerBase nearest = null;
         float minDistance = m_Config.AgroRange;
 
-        foreach (PlayerBase player : players)
+        // Реестр онлайн-игроков - без аллокации массива каждый кадр
+        foreach (PlayerBase player : PlayerRegistry.GetInstance().GetPlayers())
         {
             float distance = vector.Distance(GetPosition(), player.GetPosition());
 
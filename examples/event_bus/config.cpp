@@ -0,0 +1,38 @@
+// config.cpp
+// Gameplay event bus configuration
+
+class CfgPatches
+{
+    class GameEventBus
+    {
+        units[]={};
+        weapons[]={};
+        requiredVersion=0.1;
+        requiredAddons[]={"DZ_Data", "DZ_Scripts", "ModLogger"};
+    };
+};
+
+class CfgMods
+{
+    class GameEventBus
+    {
+        type="mod";
+        author="DayZ Training";
+        dir="GameEventBus";
+        name="Game Event Bus";
+        dependencies[]={"Game", "World"};
+        class defs
+        {
+            class gameScriptModule
+            {
+                value="";
+                files[]={"GameEventBus/Scripts/3_Game"};
+            };
+            class worldScriptModule
+            {
+                value="";
+                files[]={"GameEventBus/Scripts/4_World"};
+            };
+        };
+    };
+};
@@ -0,0 +1,281 @@
+// ============================================================
+// GAME EVENT BUS - Typed gameplay events shared by mods
+// ============================================================
+// Kill, craft and read hooks are overridden once (4_World publishers).
+// Each publishes one pre-resolved event (player IDs, types, weapon,
+// position) and every subscriber of that event type gets it:
+//
+//     class MyKillListener : GameEventListener
+//     {
+//         override void OnKill(GameKillEvent e)
+//         {
+//             if (e.VictimIsInfected && e.Killer) ...
+//         }
+//     }
+//
+//     GameEventBus.GetInstance().Subscribe(GameEventType.KILL, new MyKillListener(), "MyMod");
+//
+// Dispatch is one loop over that type's subscribers (no casts: the
+// event calls the matching listener method). Time spent in each
+// subscriber is counted; see LogStats().
+//
+// Events are built on the server only.
+
+enum GameEventType
+{
+    KILL,       // Player or infected died
+    CRAFT,      // Player crafted an item
+    READ,       // Player read a book
+    COUNT
+}
+
+// ============================================================
+// EVENTS
+// ============================================================
+class GameEvent
+{
+    int Type;               // GameEventType
+    vector Position;        // Where it happened
+
+    // Calls the listener method for this event type
+    void DispatchTo(GameEventListener listener);
+}
+
+class GameKillEvent : GameEvent
+{
+    Man Killer;             // Player responsible (null for zombies, falls, ...)
+    string KillerID;        // Killer identity ID ("" if no player)
+    string Weapon;          // Item in the killer's hands ("" if none)
+    EntityAI Victim;
+    string VictimType;      // Victim class name
+    string VictimID;        // Victim identity ID ("" if not a player)
+    bool VictimIsPlayer;
+    bool VictimIsInfected;
+
+    void GameKillEvent()
+    {
+        Type = GameEventType.KILL;
+    }
+
+    override void DispatchTo(GameEventListener listener)
+    {
+        listener.OnKill(this);
+    }
+}
+
+class GameCraftEvent : GameEvent
+{
+    Man Player;
+    string PlayerID;
+    EntityAI Item;
+    string ItemType;
+
+    void GameCraftEvent()
+    {
+        Type = GameEventType.CRAFT;
+    }
+
+    override void DispatchTo(GameEventListener listener)
+    {
+        listener.OnCraft(this);
+    }
+}
+
+class GameReadEvent : GameEvent
+{
+    Man Player;
+    string PlayerID;
+    EntityAI Book;
+    string BookType;
+
+    void GameReadEvent()
+    {
+        Type = GameEventType.READ;
+    }
+
+    override void DispatchTo(GameEventListener listener)
+    {
+        listener.OnRead(this);
+    }
+}
+
+// ============================================================
+// LISTENER - Override the methods for the subscribed types
+// ============================================================
+class GameEventListener
+{
+    void OnKill(GameKillEvent e);
+    void OnCraft(GameCraftEvent e);
+    void OnRead(GameReadEvent e);
+}
+
+// ============================================================
+// SUBSCRIPTION - Listener plus timing counters
+// ============================================================
+class GameEventSubscription
+{
+    string Name;
+    int Type;
+    ref GameEventListener Listener;
+
+    int Calls;
+    float TotalMs;
+    float MaxMs;
+
+    float GetAverageMs()
+    {
+        if (Calls == 0)
+        {
+            return 0;
+        }
+
+        return TotalMs / Calls;
+    }
+}
+
+class GameEventBus
+{
+    static const string LOG_MODULE = "EventBus";
+
+    protected ref array<ref array<ref GameEventSubscription>> m_Subscriptions;  // Per GameEventType
+    protected bool m_TimingEnabled;
+
+    private static ref GameEventBus m_Instance;
+
+    // ============================================================
+    // GET INSTANCE - Singleton pattern
+    // ============================================================
+    static GameEventBus GetInstance()
+    {
+        if (!m_Instance)
+        {
+            m_Instance = new GameEventBus();
+        }
+
+        return m_Instance;
+    }
+
+    void GameEventBus()
+    {
+        m_Subscriptions = new array<ref array<ref GameEventSubscription>>;
+        m_TimingEnabled = true;
+
+        for (int type = 0; type < GameEventType.COUNT; type++)
+        {
+            m_Subscriptions.Insert(new array<ref GameEventSubscription>);
+        }
+    }
+
+    // ============================================================
+    // SUBSCRIBE - One listener per call; the bus keeps it alive
+    // ============================================================
+    GameEventSubscription Subscribe(int type, GameEventListener listener, string name)
+    {
+        if (type < 0 || type >= GameEventType.COUNT || !listener)
+        {
+            return null;
+        }
+
+        GameEventSubscription subscription = new GameEventSubscription();
+        subscription.Name = name;
+        subscription.Type = type;
+        subscription.Listener = listener;
+        m_Subscriptions[type].Insert(subscription);
+
+        if (ModLogger.IsEnabled(LOG_MODULE, ModLogLevel.INFO))
+        {
+            ModLogger.Info(LOG_MODULE, name + " subscribed to " + typename.EnumToString(GameEventType, type));
+        }
+
+        return subscription;
+    }
+
+    // Removes the listener from every event type
+    void Unsubscribe(GameEventListener listener)
+    {
+        foreach (array<ref GameEventSubscription> subscriptions : m_Subscriptions)
+        {
+            for (int i = subscriptions.Count() - 1; i >= 0; i--)
+            {
+                if (subscriptions[i].Listener == listener)
+                {
+                    subscriptions.RemoveOrdered(i);
+                }
+            }
+        }
+    }
+
+    // Publishers check this before resolving an event
+    bool HasSubscribers(int type)
+    {
+        return m_Subscriptions[type].Count() > 0;
+    }
+
+    // ============================================================
+    // PUBLISH - O(subscribers of this type)
+    // ============================================================
+    void Publish(GameEvent e)
+    {
+        array<ref GameEventSubscription> subscriptions = m_Subscriptions[e.Type];
+
+        // Count taken once - subscriptions added during dispatch wait for the next event
+        int count = subscriptions.Count();
+        for (int i = 0; i < count && i < subscriptions.Count(); i++)
+        {
+            GameEventSubscription subscription = subscriptions[i];
+
+            if (!m_TimingEnabled)
+            {
+                e.DispatchTo(subscription.Listener);
+                continue;
+            }
+
+            int start = TickCount(0);
+            e.DispatchTo(subscription.Listener);
+
+            // TickCount is in 1/10000 ms units
+            float elapsedMs = TickCount(start) / 10000.0;
+            subscription.Calls++;
+            subscription.TotalMs += elapsedMs;
+            subscription.MaxMs = Math.Max(subscription.MaxMs, elapsedMs);
+        }
+    }
+
+    // ============================================================
+    // TIMING
+    // ============================================================
+    void SetTimingEnabled(bool enabled)
+    {
+        m_TimingEnabled = enabled;
+    }
+
+    array<ref GameEventSubscription> GetSubscriptions(int type)
+    {
+        return m_Subscriptions[type];
+    }
+
+    void ResetStats()
+    {
+        foreach (array<ref GameEventSubscription> subscriptions : m_Subscriptions)
+        {
+            foreach (GameEventSubscription subscription : subscriptions)
+            {
+                subscription.Calls = 0;
+                subscription.TotalMs = 0;
+                subscription.MaxMs = 0;
+            }
+        }
+    }
+
+    // One line per subscriber: calls, average and max time
+    void LogStats()
+    {
+        for (int type = 0; type < GameEventType.COUNT; type++)
+        {
+            foreach (GameEventSubscription subscription : m_Subscriptions[type])
+            {
+                ModLogger.Info(LOG_MODULE, typename.EnumToString(GameEventType, type) + " " + subscription.Name + ": " + subscription.Calls.ToString() + " call(s), avg " + subscription.GetAverageMs().ToString() + " ms, max " + subscription.MaxMs.ToString() + " ms");
+            }
+        }
+    }
+}
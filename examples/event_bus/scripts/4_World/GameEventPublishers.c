@@ -0,0 +1,136 @@
+// ============================================================
+// GAME EVENT PUBLISHERS - The only kill/craft/read overrides
+// ============================================================
+// Each hook resolves the event once (casts, identities, types) and
+// only when something is subscribed to that event type.
+
+class GameEventFactory
+{
+    static GameKillEvent CreateKill(EntityAI victim, Object killer)
+    {
+        GameKillEvent e = new GameKillEvent();
+        e.Victim = victim;
+        e.VictimType = victim.GetType();
+        e.Position = victim.GetPosition();
+        e.VictimIsInfected = victim.IsInherited(DayZInfected);
+
+        Man victimMan = Man.Cast(victim);
+        if (victimMan && victimMan.IsPlayer())
+        {
+            e.VictimIsPlayer = true;
+            e.VictimID = GetIdentityID(victimMan);
+        }
+
+        // Killer may be the player, their weapon or a projectile owner
+        EntityAI killerEntity = EntityAI.Cast(killer);
+        if (killerEntity)
+        {
+            Man killerMan = killerEntity.GetHierarchyRootPlayer();
+            if (killerMan && killerMan.IsPlayer() && killerMan != victim)
+            {
+                e.Killer = killerMan;
+                e.KillerID = GetIdentityID(killerMan);
+
+                EntityAI inHands = killerMan.GetHumanInventory().GetEntityInHands();
+                if (inHands)
+                {
+                    e.Weapon = inHands.GetType();
+                }
+            }
+        }
+
+        return e;
+    }
+
+    static GameCraftEvent CreateCraft(Man player, EntityAI item)
+    {
+        GameCraftEvent e = new GameCraftEvent();
+        e.Player = player;
+        e.PlayerID = GetIdentityID(player);
+        e.Item = item;
+        e.Position = player.GetPosition();
+
+        if (item)
+        {
+            e.ItemType = item.GetType();
+        }
+
+        return e;
+    }
+
+    static GameReadEvent CreateRead(Man player, EntityAI book)
+    {
+        GameReadEvent e = new GameReadEvent();
+        e.Player = player;
+        e.PlayerID = GetIdentityID(player);
+        e.Book = book;
+        e.Position = player.GetPosition();
+
+        if (book)
+        {
+            e.BookType = book.GetType();
+        }
+
+        return e;
+    }
+
+    static string GetIdentityID(Man player)
+    {
+        if (!player || !player.GetIdentity())
+        {
+            return "";
+        }
+
+        return player.GetIdentity().GetId();
+    }
+}
+
+modded class PlayerBase
+{
+    override void EEKilled(Object killer)
+    {
+        super.EEKilled(killer);
+
+        GameEventBus bus = GameEventBus.GetInstance();
+        if (GetGame().IsServer() && bus.HasSubscribers(GameEventType.KILL))
+        {
+            bus.Publish(GameEventFactory.CreateKill(this, killer));
+        }
+    }
+
+    override void CraftItem(ItemBase item)
+    {
+        super.CraftItem(item);
+
+        GameEventBus bus = GameEventBus.GetInstance();
+        if (GetGame().IsServer() && bus.HasSubscribers(GameEventType.CRAFT))
+        {
+            bus.Publish(GameEventFactory.CreateCraft(this, item));
+        }
+    }
+
+    override void ReadItem(ItemBase book)
+    {
+        super.ReadItem(book);
+
+        GameEventBus bus = GameEventBus.GetInstance();
+        if (GetGame().IsServer() && bus.HasSubscribers(GameEventType.READ))
+        {
+            bus.Publish(GameEventFactory.CreateRead(this, book));
+        }
+    }
+}
+
+modded class ZombieBase
+{
+    override void EEKilled(Object killer)
+    {
+        super.EEKilled(killer);
+
+        GameEventBus bus = GameEventBus.GetInstance();
+        if (GetGame().IsServer() && bus.HasSubscribers(GameEventType.KILL))
+        {
+            bus.Publish(GameEventFactory.CreateKill(this, killer));
+        }
+    }
+}
@@ -11,7 +11,9 @@ class CfgPatches
         requiredAddons[]=
         {
             "DZ_Data",
-            "DZ_Scripts"
+            "DZ_Scripts",
+            "ModLogger",
+            "GameEventBus"
         };
     };
 };
@@ -10,6 +10,15 @@ class FactionConstants
     static const string FACTION_GIALLI = "Gialli";
     static const string FACTION_HIVE = "Hive";
 
+    // Faction IDs (dense index assigned by FactionManager at startup)
+    static const int FACTION_NONE = -1;
+    static const int MAX_FACTIONS = 32;              // Wanted flags are a 32-bit mask
+
+    // Relation matrix values
+    static const int RELATION_NEUTRAL = 0;
+    static const int RELATION_FRIENDLY = 1;
+    static const int RELATION_HOSTILE = 2;
+
     // Reputation thresholds
     static const int REPUTATION_HOSTILE = -50;   // Below: KOS
     static const int REPUTATION_NEUTRAL = 0;     // Neutral
@@ -9,9 +9,11 @@ class FactionData
     ref array<string> FriendlyFactions;    // Allied factions
     ref array<string> HostileFactions;     // Enemy factions
     string Color;                          // UI color (e.g., "0 0 255")
+    int ID;                                // Dense index (set by FactionManager)
 
     void FactionData()
     {
+        ID = FactionConstants.FACTION_NONE;
         Name = "";
         LoadoutName = "";
         FriendlyFactions = new array<string>();
@@ -21,89 +23,166 @@ class FactionData
 }
 
 // Player faction data
+// At runtime reputation is a dense array and wanted flags a bitmask,
+// both indexed by faction ID. The Reputation/Wanted maps are only the
+// JSON form (players.json schema): filled by ToJson before saving and
+// converted by FromJson after loading.
 class PlayerFactionData
 {
-    string FactionName;        // Current faction
-    ref map<string, int> Reputation;  // Reputation per faction
-    ref map<string, bool> Wanted;     // Wanted status per faction
+    string FactionName;                // Current faction
+    ref map<string, int> Reputation;   // JSON only - reputation per faction name
+    ref map<string, bool> Wanted;      // JSON only - wanted status per faction name
+
+    [NonSerialized()]
+    int FactionID;                     // Resolved from FactionName (FACTION_NONE if none)
+
+    [NonSerialized()]
+    protected ref array<int> m_Reputation;    // Indexed by faction ID
+
+    [NonSerialized()]
+    protected int m_WantedMask;               // Bit per faction ID
 
     void PlayerFactionData()
     {
         FactionName = "";
+        FactionID = FactionConstants.FACTION_NONE;
         Reputation = new map<string, int>();
         Wanted = new map<string, bool>();
+        m_Reputation = new array<int>();
+        m_WantedMask = 0;
     }
 
     // Get reputation with faction
-    int GetReputation(string faction)
+    int GetReputation(int factionID)
     {
-        if (!Reputation.Contains(faction))
+        if (factionID < 0 || factionID >= m_Reputation.Count())
         {
-            Reputation.Insert(faction, 0); // Default neutral
+            return FactionConstants.REPUTATION_NEUTRAL;
         }
-        return Reputation.Get(faction);
+        return m_Reputation[factionID];
     }
 
     // Set reputation with faction
-    void SetReputation(string faction, int value)
+    void SetReputation(int factionID, int value)
     {
-        if (!Reputation.Contains(faction))
-        {
-            Reputation.Insert(faction, value);
-        }
-        else
+        if (factionID < 0 || factionID >= FactionConstants.MAX_FACTIONS) return;
+
+        while (m_Reputation.Count() <= factionID)
         {
-            Reputation.Set(faction, value);
+            m_Reputation.Insert(FactionConstants.REPUTATION_NEUTRAL);
         }
+        m_Reputation[factionID] = value;
 
         // Check if wanted
         if (value < FactionConstants.WANTED_THRESHOLD)
         {
-            SetWanted(faction, true);
+            SetWanted(factionID, true);
         }
     }
 
     // Add reputation to faction
-    void AddReputation(string faction, int amount)
+    void AddReputation(int factionID, int amount)
     {
-        int current = GetReputation(faction);
-        SetReputation(faction, current + amount);
+        SetReputation(factionID, GetReputation(factionID) + amount);
     }
 
     // Check if wanted by faction
-    bool IsWanted(string faction)
+    bool IsWanted(int factionID)
     {
-        if (!Wanted.Contains(faction))
-        {
-            return false;
-        }
-        return Wanted.Get(faction);
+        if (factionID < 0 || factionID >= FactionConstants.MAX_FACTIONS) return false;
+        return (m_WantedMask & (1 << factionID)) != 0;
     }
 
     // Set wanted status
-    void SetWanted(string faction, bool wanted)
+    void SetWanted(int factionID, bool wanted)
     {
-        if (!Wanted.Contains(faction))
+        if (factionID < 0 || factionID >= FactionConstants.MAX_FACTIONS) return;
+
+        if (wanted)
         {
-            Wanted.Insert(faction, wanted);
+            m_WantedMask = m_WantedMask | (1 << factionID);
         }
         else
         {
-            Wanted.Set(faction, wanted);
+            m_WantedMask = m_WantedMask & ~(1 << factionID);
         }
     }
 
+    // Bit per faction ID - non-zero if wanted by any faction
+    int GetWantedMask()
+    {
+        return m_WantedMask;
+    }
+
     // Check if friendly to player
-    bool IsFriendly(string otherFaction)
+    bool IsFriendly(int otherFactionID)
     {
-        int rep = GetReputation(otherFaction);
-        return rep >= FactionConstants.REPUTATION_FRIENDLY;
+        return GetReputation(otherFactionID) >= FactionConstants.REPUTATION_FRIENDLY;
     }
 
     // Check if hostile to player
-    bool IsHostile(string otherFaction)
+    bool IsHostile(int otherFactionID)
     {
-        int rep = GetReputation(otherFaction);
-        return rep <= FactionConstants.REPUTATION_HOSTILE;
+        return GetReputation(otherFactionID) <= FactionConstants.REPUTATION_HOSTILE;
+    }
+
+    // JSON maps -> dense storage (after loading). Unknown faction names are dropped.
+    void FromJson(FactionManager manager)
+    {
+        FactionID = manager.GetFactionID(FactionName);
+        m_Reputation.Clear();
+        m_WantedMask = 0;
+
+        if (Reputation)
+        {
+            foreach (string repFaction, int value : Reputation)
+            {
+                int repID = manager.GetFactionID(repFaction);
+                if (repID == FactionConstants.FACTION_NONE) continue;
+
+                // Not SetReputation - the saved wanted flags are authoritative
+                while (m_Reputation.Count() <= repID)
+                {
+                    m_Reputation.Insert(FactionConstants.REPUTATION_NEUTRAL);
+                }
+                m_Reputation[repID] = value;
+            }
+        }
+
+        if (Wanted)
+        {
+            foreach (string wantedFaction, bool wanted : Wanted)
+            {
+                SetWanted(manager.GetFactionID(wantedFaction), wanted);
+            }
+        }
+
+        ClearJson();
+    }
+
+    // Dense storage -> JSON maps (before saving); call ClearJson afterwards
+    void ToJson(FactionManager manager)
+    {
+        ClearJson();
+
+        for (int id = 0; id < manager.GetFactionCount(); id++)
+        {
+            string name = manager.GetFactionDataByID(id).Name;
+            Reputation.Insert(name, GetReputation(id));
+
+            if (IsWanted(id))
+            {
+                Wanted.Insert(name, true);
+            }
+        }
+    }
+
+    void ClearJson()
+    {
+        if (!Reputation) Reputation = new map<string, int>();
+        if (!Wanted) Wanted = new map<string, bool>();
+
+        Reputation.Clear();
+        Wanted.Clear();
     }
 }
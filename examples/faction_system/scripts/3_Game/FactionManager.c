@@ -3,8 +3,25 @@
 
 class FactionManager
 {
+    static const string DATA_DIR = "$profile:Factions";
+    static const string PLAYERS_DIR = "$profile:Factions/players/";
+    static const string LEGACY_FILE = "$profile:Factions/players.json";
+    static const int FLUSH_INTERVAL_MS = 60000;
+
     protected ref map<string, ref FactionData> m_Factions;
-    protected ref map<string, ref PlayerFactionData> m_PlayerData;
+    protected ref map<string, ref PlayerFactionData> m_PlayerData;  // Online (and recently seen) players
+
+    // Players whose record changed since the last flush
+    protected ref array<string> m_DirtyPlayers;
+    protected bool m_FlushScheduled;
+
+    // Factions by ID, and relations as a dense N x N matrix
+    // (m_Relations[a * N + b] = relation of faction a towards b)
+    protected ref array<ref FactionData> m_FactionList;
+    protected ref array<int> m_Relations;
+
+    // Online players per faction ID (server)
+    protected ref array<ref array<PlayerBase>> m_OnlineMembers;
 
     protected static ref FactionManager m_Instance;
 
@@ -12,8 +29,14 @@ class FactionManager
     {
         m_Factions = new map<string, ref FactionData>();
         m_PlayerData = new map<string, ref PlayerFactionData>();
+        m_FactionList = new array<ref FactionData>();
+        m_Relations = new array<int>();
+        m_OnlineMembers = new array<ref array<PlayerBase>>();
+        m_DirtyPlayers = new array<string>();
+        m_FlushScheduled = false;
 
         InitializeFactions();
+        LoadData();
     }
 
     // Get singleton instance
@@ -36,7 +59,7 @@ class FactionManager
         blu.Color = "0 0 255"; // Blue
         blu.FriendlyFactions = {"Verde", "Gialli"};
         blu.HostileFactions = {"Rossi", "Hive"};
-        m_Factions.Insert("Blu", blu);
+        RegisterFaction(blu);
 
         // Rossi Faction (Red)
         FactionData rossi = new FactionData();
@@ -45,7 +68,7 @@ class FactionManager
         rossi.Color = "255 0 0"; // Red
         rossi.FriendlyFactions = {"Hive"};
         rossi.HostileFactions = {"Blu", "Verde", "Gialli"};
-        m_Factions.Insert("Rossi", rossi);
+        RegisterFaction(rossi);
 
         // Verde Faction (Green)
         FactionData verde = new FactionData();
@@ -54,7 +77,7 @@ class FactionManager
         verde.Color = "0 255 0"; // Green
         verde.FriendlyFactions = {"Blu", "Gialli"};
         verde.HostileFactions = {"Rossi", "Hive"};
-        m_Factions.Insert("Verde", verde);
+        RegisterFaction(verde);
 
         // Gialli Faction (Yellow)
         FactionData gialli = new FactionData();
@@ -63,7 +86,7 @@ class FactionManager
         gialli.Color = "255 255 0"; // Yellow
         gialli.FriendlyFactions = {"Blu", "Verde"};
         gialli.HostileFactions = {"Rossi", "Hive"};
-        m_Factions.Insert("Gialli", gialli);
+        RegisterFaction(gialli);
 
         // Hive Faction (Purple/Enemy)
         FactionData hive = new FactionData();
@@ -72,9 +95,67 @@ class FactionManager
         hive.Color = "128 0 128"; // Purple
         hive.FriendlyFactions = {"Rossi"};
         hive.HostileFactions = {"Blu", "Verde", "Gialli"};
-        m_Factions.Insert("Hive", hive);
+        RegisterFaction(hive);
+
+        BuildRelations();
+        ModLogger.Info("FactionManager", "Initialized " + m_Factions.Count() + " factions");
+    }
 
-        Print("[FactionManager] Initialized " + m_Factions.Count() + " factions");
+    // Add a faction and assign its ID (call BuildRelations afterwards)
+    void RegisterFaction(FactionData faction)
+    {
+        if (m_FactionList.Count() >= FactionConstants.MAX_FACTIONS)
+        {
+            ModLogger.Error("FactionManager", "Cannot register " + faction.Name + ": limit of " + FactionConstants.MAX_FACTIONS.ToString() + " factions");
+            return;
+        }
+
+        faction.ID = m_FactionList.Count();
+        m_FactionList.Insert(faction);
+        m_OnlineMembers.Insert(new array<PlayerBase>());
+        m_Factions.Insert(faction.Name, faction);
+    }
+
+    // Precompute the relation matrix from FriendlyFactions/HostileFactions
+    void BuildRelations()
+    {
+        int count = m_FactionList.Count();
+        m_Relations.Clear();
+
+        for (int i = 0; i < count * count; i++)
+        {
+            m_Relations.Insert(FactionConstants.RELATION_NEUTRAL);
+        }
+
+        foreach (FactionData faction : m_FactionList)
+        {
+            // Same faction
+            m_Relations[faction.ID * count + faction.ID] = FactionConstants.RELATION_FRIENDLY;
+
+            foreach (string friendly : faction.FriendlyFactions)
+            {
+                int friendlyID = GetFactionID(friendly);
+                if (friendlyID != FactionConstants.FACTION_NONE)
+                {
+                    m_Relations[faction.ID * count + friendlyID] = FactionConstants.RELATION_FRIENDLY;
+                }
+            }
+
+            foreach (string hostile : faction.HostileFactions)
+            {
+                int hostileID = GetFactionID(hostile);
+                if (hostileID != FactionConstants.FACTION_NONE)
+                {
+                    m_Relations[faction.ID * count + hostileID] = FactionConstants.RELATION_HOSTILE;
+                }
+            }
+        }
+
+        // IDs of loaded players were resolved against the old list
+        foreach (string playerID, PlayerFactionData data : m_PlayerData)
+        {
+            data.FactionID = GetFactionID(data.FactionName);
+        }
     }
 
     // Get faction data
@@ -87,53 +168,107 @@ class FactionManager
         return m_Factions.Get(factionName);
     }
 
-    // Check if two factions are friendly
-    bool IsFriendly(string faction1, string faction2)
+    // Get faction data by ID
+    FactionData GetFactionDataByID(int factionID)
     {
-        if (faction1 == faction2) return true; // Same faction
-
-        FactionData data = GetFactionData(faction1);
-        if (!data) return false;
+        if (factionID < 0 || factionID >= m_FactionList.Count())
+        {
+            return null;
+        }
+        return m_FactionList[factionID];
+    }
 
-        foreach (string friendly : data.FriendlyFactions)
+    // Faction name -> ID (FACTION_NONE if unknown or empty)
+    int GetFactionID(string factionName)
+    {
+        FactionData data;
+        if (!m_Factions.Find(factionName, data))
         {
-            if (friendly == faction2)
-            {
-                return true;
-            }
+            return FactionConstants.FACTION_NONE;
         }
+        return data.ID;
+    }
 
-        return false;
+    int GetFactionCount()
+    {
+        return m_FactionList.Count();
     }
 
-    // Check if two factions are hostile
-    bool IsHostile(string faction1, string faction2)
+    // Relation of faction1 towards faction2 (RELATION_*)
+    int GetRelation(int faction1, int faction2)
+    {
+        int count = m_FactionList.Count();
+        if (faction1 < 0 || faction2 < 0 || faction1 >= count || faction2 >= count)
+        {
+            return FactionConstants.RELATION_NEUTRAL;
+        }
+        return m_Relations[faction1 * count + faction2];
+    }
+
+    // Change one relation at runtime (keeps the faction lists in sync)
+    void SetRelation(int faction1, int faction2, int relation)
     {
-        if (faction1 == faction2) return false; // Same faction
+        FactionData data = GetFactionDataByID(faction1);
+        FactionData other = GetFactionDataByID(faction2);
+        if (!data || !other || faction1 == faction2) return;
 
-        FactionData data = GetFactionData(faction1);
-        if (!data) return false;
+        data.FriendlyFactions.RemoveItem(other.Name);
+        data.HostileFactions.RemoveItem(other.Name);
 
-        foreach (string hostile : data.HostileFactions)
+        if (relation == FactionConstants.RELATION_FRIENDLY)
         {
-            if (hostile == faction2)
-            {
-                return true;
-            }
+            data.FriendlyFactions.Insert(other.Name);
         }
+        else if (relation == FactionConstants.RELATION_HOSTILE)
+        {
+            data.HostileFactions.Insert(other.Name);
+        }
+
+        m_Relations[faction1 * m_FactionList.Count() + faction2] = relation;
+    }
+
+    // Check if two factions are friendly (by ID)
+    bool IsFriendlyID(int faction1, int faction2)
+    {
+        return GetRelation(faction1, faction2) == FactionConstants.RELATION_FRIENDLY;
+    }
+
+    // Check if two factions are hostile (by ID)
+    bool IsHostileID(int faction1, int faction2)
+    {
+        return GetRelation(faction1, faction2) == FactionConstants.RELATION_HOSTILE;
+    }
+
+    // Check if two factions are friendly
+    bool IsFriendly(string faction1, string faction2)
+    {
+        return IsFriendlyID(GetFactionID(faction1), GetFactionID(faction2));
+    }
 
-        return false;
+    // Check if two factions are hostile
+    bool IsHostile(string faction1, string faction2)
+    {
+        return IsHostileID(GetFactionID(faction1), GetFactionID(faction2));
     }
 
-    // Get player data
+    // Get player data (loads only this player's record on first use)
     PlayerFactionData GetPlayerData(string playerID)
     {
-        if (!m_PlayerData.Contains(playerID))
+        PlayerFactionData data;
+        if (!m_PlayerData.Find(playerID, data))
         {
-            PlayerFactionData data = new PlayerFactionData();
+            data = LoadPlayer(playerID);
             m_PlayerData.Insert(playerID, data);
         }
-        return m_PlayerData.Get(playerID);
+        return data;
+    }
+
+    // Get player data (one identity lookup - fetch once, then query by faction ID)
+    PlayerFactionData GetPlayerDataOf(PlayerBase player)
+    {
+        if (!player || !player.GetIdentity()) return null;
+
+        return GetPlayerData(player.GetIdentity().GetId());
     }
 
     // Set player faction
@@ -143,24 +278,25 @@ class FactionManager
 
         string playerID = player.GetIdentity().GetId();
         PlayerFactionData data = GetPlayerData(playerID);
+
+        RemoveOnlineMember(player);
         data.FactionName = factionName;
+        data.FactionID = GetFactionID(factionName);
+        player.SetFactionID(data.FactionID);
+        AddOnlineMember(player);
 
-        // Initialize reputation with all factions
-        foreach (string faction, FactionData factionData : m_Factions)
+        // Start with friendly reputation to own faction (others default to neutral)
+        if (data.FactionID != FactionConstants.FACTION_NONE)
         {
-            if (!data.Reputation.Contains(faction))
-            {
-                data.Reputation.Insert(faction, FactionConstants.REPUTATION_NEUTRAL);
-            }
+            data.SetReputation(data.FactionID, FactionConstants.REPUTATION_FRIENDLY);
         }
 
-        // Start with friendly reputation to own faction
-        if (factionName != "")
+        MarkDirty(playerID);
+
+        if (ModLogger.IsEnabled("FactionManager", ModLogLevel.INFO))
         {
-            data.SetReputation(factionName, FactionConstants.REPUTATION_FRIENDLY);
+            ModLogger.Info("FactionManager", "Player " + playerID + " joined faction: " + factionName);
         }
-
-        Print("[FactionManager] Player " + playerID + " joined faction: " + factionName);
     }
 
     // Get player faction
@@ -173,6 +309,16 @@ class FactionManager
         return data.FactionName;
     }
 
+    // Get player faction ID (cache it - see PlayerBase.GetFactionID)
+    int GetFactionIDOf(PlayerBase player)
+    {
+        if (!player) return FactionConstants.FACTION_NONE;
+
+        string playerID = player.GetIdentity().GetId();
+        PlayerFactionData data = GetPlayerData(playerID);
+        return data.FactionID;
+    }
+
     // Add reputation to player
     void AddReputation(PlayerBase player, string faction, int amount)
     {
@@ -180,10 +326,17 @@ class FactionManager
 
         string playerID = player.GetIdentity().GetId();
         PlayerFactionData data = GetPlayerData(playerID);
-        data.AddReputation(faction, amount);
+        int factionID = GetFactionID(faction);
+        data.AddReputation(factionID, amount);
+        MarkDirty(playerID);
 
-        int newRep = data.GetReputation(faction);
-        Print("[FactionManager] Player " + playerID + " reputation with " + faction + ": " + newRep.ToString());
+#ifdef DEVELOPER
+        int newRep = data.GetReputation(factionID);
+        if (ModLogger.IsEnabled("FactionManager", ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug("FactionManager", "Player " + playerID + " reputation with " + faction + ": " + newRep.ToString());
+        }
+#endif
     }
 
     // Get player reputation with faction
@@ -193,7 +346,7 @@ class FactionManager
 
         string playerID = player.GetIdentity().GetId();
         PlayerFactionData data = GetPlayerData(playerID);
-        return data.GetReputation(faction);
+        return data.GetReputation(GetFactionID(faction));
     }
 
     // Check if player is wanted by faction
@@ -203,7 +356,7 @@ class FactionManager
 
         string playerID = player.GetIdentity().GetId();
         PlayerFactionData data = GetPlayerData(playerID);
-        return data.IsWanted(faction);
+        return data.IsWanted(GetFactionID(faction));
     }
 
     // Set wanted status
@@ -213,9 +366,13 @@ class FactionManager
 
         string playerID = player.GetIdentity().GetId();
         PlayerFactionData data = GetPlayerData(playerID);
-        data.SetWanted(faction, wanted);
+        data.SetWanted(GetFactionID(faction), wanted);
+        MarkDirty(playerID);
 
-        Print("[FactionManager] Player " + playerID + " wanted by " + faction + ": " + wanted.ToString());
+        if (ModLogger.IsEnabled("FactionManager", ModLogLevel.INFO))
+        {
+            ModLogger.Info("FactionManager", "Player " + playerID + " wanted by " + faction + ": " + wanted.ToString());
+        }
     }
 
     // Handle player killed (reputation changes)
@@ -223,73 +380,279 @@ class FactionManager
     {
         if (!killer || !victim) return;
 
-        FactionManager manager = FactionManager.GetInstance();
-
-        string killerFaction = manager.GetFaction(killer);
-        string victimFaction = manager.GetFaction(victim);
+        int killerID = killer.GetFactionID();
+        int victimID = victim.GetFactionID();
 
         // Both in factions
-        if (killerFaction != "" && victimFaction != "")
+        if (killerID != FactionConstants.FACTION_NONE && victimID != FactionConstants.FACTION_NONE)
         {
+            if (!killer.GetIdentity()) return;
+
+            string killerPlayerID = killer.GetIdentity().GetId();
+            PlayerFactionData killerData = GetPlayerData(killerPlayerID);
+            MarkDirty(killerPlayerID);
+
             // Same faction (killed ally)
-            if (killerFaction == victimFaction)
+            if (killerID == victimID)
             {
-                manager.AddReputation(killer, killerFaction, FactionConstants.REPUTATION_KILL_ALLY);
-                Print("[FactionManager] " + killer.GetIdentity().GetName() + " killed ally! -" + FactionConstants.REPUTATION_KILL_ALLY.ToString());
+                killerData.AddReputation(killerID, FactionConstants.REPUTATION_KILL_ALLY);
+#ifdef DEVELOPER
+                if (ModLogger.IsEnabled("FactionManager", ModLogLevel.DEBUG))
+                {
+                    ModLogger.Debug("FactionManager", killer.GetIdentity().GetName() + " killed ally! -" + FactionConstants.REPUTATION_KILL_ALLY.ToString());
+                }
+#endif
             }
             // Different factions
             else
             {
                 // Check if hostile
-                if (manager.IsHostile(killerFaction, victimFaction))
+                if (IsHostileID(killerID, victimID))
                 {
                     // Killed enemy
-                    manager.AddReputation(killer, killerFaction, FactionConstants.REPUTATION_KILL_ENEMY);
-                    Print("[FactionManager] " + killer.GetIdentity().GetName() + " killed enemy! +" + FactionConstants.REPUTATION_KILL_ENEMY.ToString());
+                    killerData.AddReputation(killerID, FactionConstants.REPUTATION_KILL_ENEMY);
+#ifdef DEVELOPER
+                    if (ModLogger.IsEnabled("FactionManager", ModLogLevel.DEBUG))
+                    {
+                        ModLogger.Debug("FactionManager", killer.GetIdentity().GetName() + " killed enemy! +" + FactionConstants.REPUTATION_KILL_ENEMY.ToString());
+                    }
+#endif
                 }
                 else
                 {
                     // Killed neutral/friendly
-                    manager.AddReputation(killer, victimFaction, FactionConstants.REPUTATION_KILL_ALLY);
-                    Print("[FactionManager] " + killer.GetIdentity().GetName() + " killed neutral! -" + FactionConstants.REPUTATION_KILL_ALLY.ToString());
+                    killerData.AddReputation(victimID, FactionConstants.REPUTATION_KILL_ALLY);
+#ifdef DEVELOPER
+                    if (ModLogger.IsEnabled("FactionManager", ModLogLevel.DEBUG))
+                    {
+                        ModLogger.Debug("FactionManager", killer.GetIdentity().GetName() + " killed neutral! -" + FactionConstants.REPUTATION_KILL_ALLY.ToString());
+                    }
+#endif
                 }
             }
         }
     }
 
-    // Save faction data to JSON
+    // Online members of a faction (do not modify; entries of deleted players may be null)
+    array<PlayerBase> GetOnlineMembers(int factionID)
+    {
+        if (factionID < 0 || factionID >= m_OnlineMembers.Count()) return null;
+
+        return m_OnlineMembers[factionID];
+    }
+
+    int GetOnlineMemberCount(int factionID)
+    {
+        array<PlayerBase> members = GetOnlineMembers(factionID);
+        if (!members) return 0;
+
+        return members.Count();
+    }
+
+    // Index a player under their cached faction ID
+    void AddOnlineMember(PlayerBase player)
+    {
+        array<PlayerBase> members = GetOnlineMembers(player.GetFactionID());
+        if (members && members.Find(player) < 0)
+        {
+            members.Insert(player);
+        }
+    }
+
+    // Remove a player from their faction's online list (disconnect, death, faction change)
+    void RemoveOnlineMember(PlayerBase player)
+    {
+        if (!player) return;
+
+        array<PlayerBase> members = GetOnlineMembers(player.GetFactionID());
+        if (!members) return;
+
+        int index = members.Find(player);
+        if (index >= 0)
+        {
+            members.Remove(index);
+        }
+    }
+
+    // Send one chat message to every online member of a faction
+    void BroadcastMessage(int factionID, string message)
+    {
+        BroadcastRPC(factionID, ERPCs.RPC_USER_ACTION_MESSAGE, new Param1<string>(message));
+    }
+
+    // Send one RPC payload to every online member of a faction
+    // (the payload is built once by the caller, no player scan)
+    void BroadcastRPC(int factionID, int rpcType, Param params, bool guaranteed = true)
+    {
+        array<PlayerBase> members = GetOnlineMembers(factionID);
+        if (!members) return;
+
+        foreach (PlayerBase member : members)
+        {
+            if (member && member.GetIdentity())
+            {
+                GetGame().RPCSingleParam(member, rpcType, params, guaranteed, member.GetIdentity());
+            }
+        }
+    }
+
+    // Mark a player's record for the next flush (call after changing PlayerFactionData)
+    void MarkDirty(string playerID)
+    {
+        if (m_DirtyPlayers.Find(playerID) < 0)
+        {
+            m_DirtyPlayers.Insert(playerID);
+        }
+
+        if (!m_FlushScheduled && GetGame())
+        {
+            m_FlushScheduled = true;
+            GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(SaveData, FLUSH_INTERVAL_MS, false);
+        }
+    }
+
+    // Write changed player records (one small file each)
     void SaveData()
     {
-        // Implementation for JSON saving
-        // Use JsonFileLoader to save m_PlayerData
-        // File location: $profile:Factions/players.json
+        m_FlushScheduled = false;
 
-        string filePath = "$profile:Factions/players.json";
+        if (m_DirtyPlayers.Count() == 0) return;
 
-        // Make directory if needed
-        if (!FileExist("$profile:Factions"))
+        int written = 0;
+        for (int i = 0; i < m_DirtyPlayers.Count(); i++)
         {
-            MakeDirectory("$profile:Factions");
+            string playerID = m_DirtyPlayers[i];
+
+            PlayerFactionData data;
+            if (m_PlayerData.Find(playerID, data))
+            {
+                SavePlayer(playerID, data);
+                written++;
+            }
         }
 
-        // Save data
-        JsonFileLoader<map<string, ref PlayerFactionData>>.JsonSaveFile(filePath, m_PlayerData);
-        Print("[FactionManager] Saved faction data for " + m_PlayerData.Count() + " players");
+        m_DirtyPlayers.Clear();
+
+#ifdef DEVELOPER
+        if (ModLogger.IsEnabled("FactionManager", ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug("FactionManager", "Saved faction data for " + written.ToString() + " players");
+        }
+#endif
     }
 
-    // Load faction data from JSON
+    // Player joined: resolve and cache the faction ID, index as online member
+    void OnPlayerConnect(PlayerBase player)
+    {
+        if (!player || !player.GetIdentity()) return;
+
+        player.SetFactionID(GetFactionIDOf(player));
+        player.SetFactionPlayerID(player.GetIdentity().GetId());
+        AddOnlineMember(player);
+    }
+
+    // Player left: write their record if changed and drop it from memory
+    void OnPlayerDisconnect(PlayerBase player)
+    {
+        RemoveOnlineMember(player);
+
+        if (!player)
+        {
+            SaveData();
+            return;
+        }
+
+        // The identity may already be gone - use the ID kept at connect
+        string playerID = player.GetFactionPlayerID();
+        if (player.GetIdentity())
+        {
+            playerID = player.GetIdentity().GetId();
+        }
+
+        if (playerID == "")
+        {
+            SaveData();
+            return;
+        }
+
+        PlayerFactionData data;
+        if (!m_PlayerData.Find(playerID, data)) return;
+
+        int dirtyIndex = m_DirtyPlayers.Find(playerID);
+        if (dirtyIndex >= 0)
+        {
+            SavePlayer(playerID, data);
+            m_DirtyPlayers.Remove(dirtyIndex);
+        }
+
+        m_PlayerData.Remove(playerID);
+    }
+
+    // Prepare the data directory and split a legacy players.json
     void LoadData()
     {
-        string filePath = "$profile:Factions/players.json";
+        if (!FileExist(DATA_DIR))
+        {
+            MakeDirectory(DATA_DIR);
+        }
 
-        if (FileExist(filePath))
+        if (!FileExist(PLAYERS_DIR))
         {
-            JsonFileLoader<map<string, ref PlayerFactionData>>.JsonLoadFile(filePath, m_PlayerData);
-            Print("[FactionManager] Loaded faction data for " + m_PlayerData.Count() + " players");
+            MakeDirectory(PLAYERS_DIR);
         }
-        else
+
+        if (!FileExist(LEGACY_FILE)) return;
+
+        // One file with every player ever seen -> one record per player
+        map<string, ref PlayerFactionData> legacy = new map<string, ref PlayerFactionData>();
+        JsonFileLoader<map<string, ref PlayerFactionData>>.JsonLoadFile(LEGACY_FILE, legacy);
+
+        foreach (string playerID, PlayerFactionData data : legacy)
         {
-            Print("[FactionManager] No existing faction data found");
+            string filePath = GetPlayerFile(playerID);
+            if (!FileExist(filePath))
+            {
+                // Still in the JSON form - write as is
+                JsonFileLoader<PlayerFactionData>.JsonSaveFile(filePath, data);
+            }
         }
+
+        CopyFile(LEGACY_FILE, LEGACY_FILE + ".migrated");
+        DeleteFile(LEGACY_FILE);
+
+        ModLogger.Info("FactionManager", "Migrated faction data for " + legacy.Count() + " players to " + PLAYERS_DIR);
+    }
+
+    // Read one player's record (new data if none)
+    protected PlayerFactionData LoadPlayer(string playerID)
+    {
+        PlayerFactionData data = new PlayerFactionData();
+
+        string filePath = GetPlayerFile(playerID);
+        if (FileExist(filePath))
+        {
+            JsonFileLoader<PlayerFactionData>.JsonLoadFile(filePath, data);
+        }
+
+        data.FromJson(this);
+        return data;
+    }
+
+    protected void SavePlayer(string playerID, PlayerFactionData data)
+    {
+        data.ToJson(this);
+        JsonFileLoader<PlayerFactionData>.JsonSaveFile(GetPlayerFile(playerID), data);
+        data.ClearJson();
+    }
+
+    // Identity IDs are base64 - make them safe as file names
+    static string GetPlayerFile(string playerID)
+    {
+        string fileName = playerID;
+        fileName.Replace("/", "_");
+        fileName.Replace("+", "-");
+        fileName.Replace("=", "");
+
+        return PLAYERS_DIR + fileName + ".json";
     }
 }
@@ -0,0 +1,16 @@
+// FactionMission.c
+// Writes changed faction records before the server shuts down
+
+modded class CustomMission
+{
+    // Dirty records are otherwise flushed every FLUSH_INTERVAL_MS
+    override void OnMissionFinish()
+    {
+        if (GetGame().IsServer())
+        {
+            FactionManager.GetInstance().SaveData();
+        }
+
+        super.OnMissionFinish();
+    }
+}
@@ -1,13 +1,83 @@
 // FactionPlayer.c
 // PlayerBase extension for faction system (kill tracking, chat commands)
 
+// Kill events from the GameEventBus (killer and victim already resolved)
+class FactionKillListener : GameEventListener
+{
+    protected static bool s_Registered;
+
+    static void Register()
+    {
+        if (s_Registered) return;
+
+        s_Registered = true;
+        GameEventBus.GetInstance().Subscribe(GameEventType.KILL, new FactionKillListener(), "FactionManager");
+    }
+
+    override void OnKill(GameKillEvent e)
+    {
+        if (!e.VictimIsPlayer) return;
+
+        FactionManager manager = FactionManager.GetInstance();
+        PlayerBase victim = PlayerBase.Cast(e.Victim);
+
+        // Dead bodies are not members; the new character connects again
+        manager.RemoveOnlineMember(victim);
+
+        PlayerBase killer = PlayerBase.Cast(e.Killer);
+        if (killer)
+        {
+            manager.OnPlayerKilled(killer, victim);
+        }
+    }
+}
+
 modded class PlayerBase
 {
     protected ref FactionManager m_FactionManager;
+    protected int m_FactionID;    // Cached faction ID (server), set by FactionManager
+    protected string m_FactionPlayerID;  // Identity ID at connect (server), for disconnect
 
     void PlayerBase()
     {
         m_FactionManager = FactionManager.GetInstance();
+        m_FactionID = FactionConstants.FACTION_NONE;
+
+        FactionKillListener.Register();
+    }
+
+    // Faction ID without identity or name lookups
+    int GetFactionID()
+    {
+        return m_FactionID;
+    }
+
+    void SetFactionID(int factionID)
+    {
+        m_FactionID = factionID;
+    }
+
+    string GetFactionPlayerID()
+    {
+        return m_FactionPlayerID;
+    }
+
+    void SetFactionPlayerID(string playerID)
+    {
+        m_FactionPlayerID = playerID;
+    }
+
+    // O(1) relation checks for AI targeting and damage hooks
+    bool IsFriendlyTo(PlayerBase other)
+    {
+        if (!other) return false;
+        return m_FactionManager.IsFriendlyID(m_FactionID, other.GetFactionID());
+    }
+
+    bool IsHostileTo(PlayerBase other)
+    {
+        if (!other) return false;
+        return m_FactionManager.IsHostileID(m_FactionID, other.GetFactionID());
     }
 
     // Called when player connects
@@ -18,18 +88,19 @@ modded class PlayerBase
         // Load faction data on server
         if (GetGame().IsServer())
         {
-            // Initialize player data if needed
-            string playerID = GetIdentity().GetId();
+            // Resolve the faction ID once per connection, index as online member
+            m_FactionManager.OnPlayerConnect(this);
 
             // Set default faction (none)
-            if (m_FactionManager.GetFaction(this) == "")
+            FactionData faction = m_FactionManager.GetFactionDataByID(m_FactionID);
+            if (!faction)
             {
                 // Player is not in any faction
                 Print("[FactionPlayer] Player " + GetIdentity().GetName() + " connected (no faction)");
             }
             else
             {
-                Print("[FactionPlayer] Player " + GetIdentity().GetName() + " connected (faction: " + m_FactionManager.GetFaction(this) + ")");
+                Print("[FactionPlayer] Player " + GetIdentity().GetName() + " connected (faction: " + faction.Name + ")");
             }
         }
     }
@@ -39,27 +110,10 @@ modded class PlayerBase
     {
         super.OnDisconnect();
 
-        // Save faction data
+        // Write this player's record (if changed) and unload it
         if (GetGame().IsServer())
         {
-            m_FactionManager.SaveData();
-        }
-    }
-
-    // Called when player is killed
-    override void EEKilled(Object killer)
-    {
-        super.EEKilled(killer);
-
-        // Handle reputation changes
-        if (GetGame().IsServer())
-        {
-            PlayerBase killerPlayer = PlayerBase.Cast(killer);
-
-            if (killerPlayer)
-            {
-                m_FactionManager.OnPlayerKilled(killerPlayer, this);
-            }
+            m_FactionManager.OnPlayerDisconnect(this);
         }
     }
 
@@ -95,6 +149,10 @@ modded class PlayerBase
             case "/wanted":
                 CommandWanted(tokens);
                 return true;
+
+            case "/f":
+                CommandFactionChat(command);
+                return true;
         }
 
         return false;
@@ -126,18 +184,19 @@ modded class PlayerBase
     // Command: /reputation or /rep
     void CommandReputation(TStringArray tokens)
     {
-        string myFaction = m_FactionManager.GetFaction(this);
+        PlayerFactionData playerData = m_FactionManager.GetPlayerDataOf(this);
 
-        if (myFaction == "")
+        if (!playerData || playerData.FactionID == FactionConstants.FACTION_NONE)
         {
             SendMessage("You are not in a faction.");
             return;
         }
 
         // Show reputation with all factions
-        foreach (string faction, FactionData data : m_FactionManager.m_Factions)
+        for (int id = 0; id < m_FactionManager.GetFactionCount(); id++)
         {
-            int rep = m_FactionManager.GetReputation(this, faction);
+            string faction = m_FactionManager.GetFactionDataByID(id).Name;
+            int rep = playerData.GetReputation(id);
 
             string status = "Neutral";
             if (rep <= FactionConstants.REPUTATION_HOSTILE)
@@ -176,37 +235,52 @@ modded class PlayerBase
         // Join faction
         m_FactionManager.SetFaction(this, factionName);
         SendMessage("You joined faction: " + factionName);
-
-        // Save data
-        m_FactionManager.SaveData();
     }
 
     // Command: /wanted
     void CommandWanted(TStringArray tokens)
     {
-        string myFaction = m_FactionManager.GetFaction(this);
+        PlayerFactionData playerData = m_FactionManager.GetPlayerDataOf(this);
 
-        if (myFaction == "")
+        if (!playerData || playerData.FactionID == FactionConstants.FACTION_NONE)
         {
             SendMessage("You are not in a faction.");
             return;
         }
 
         // Check wanted status with all factions
-        bool isWanted = false;
-        foreach (string faction, FactionData data : m_FactionManager.m_Factions)
+        if (playerData.GetWantedMask() == 0)
+        {
+            SendMessage("You are not wanted by any faction.");
+            return;
+        }
+
+        for (int id = 0; id < m_FactionManager.GetFactionCount(); id++)
         {
-            if (m_FactionManager.IsWanted(this, faction))
+            if (playerData.IsWanted(id))
             {
-                SendMessage("WANTED by " + faction + "!");
-                isWanted = true;
+                SendMessage("WANTED by " + m_FactionManager.GetFactionDataByID(id).Name + "!");
             }
         }
+    }
+
+    // Command: /f <message> - chat to online faction members
+    void CommandFactionChat(string command)
+    {
+        if (m_FactionID == FactionConstants.FACTION_NONE)
+        {
+            SendMessage("You are not in a faction.");
+            return;
+        }
 
-        if (!isWanted)
+        string message = command.Substring(2, command.Length() - 2).Trim();
+        if (message == "")
         {
-            SendMessage("You are not wanted by any faction.");
+            SendMessage("Usage: /f <message>");
+            return;
         }
+
+        m_FactionManager.BroadcastMessage(m_FactionID, "[Faction] " + GetIdentity().GetName() + ": " + message);
     }
 
     // Helper: Send message to player
@@ -11,7 +11,8 @@ class CfgPatches
         requiredAddons[]=
         {
             "DZ_Data",
-            "DZ_Scripts"
+            "DZ_Scripts",
+            "ModLogger"
         };
     };
 };
@@ -208,11 +208,16 @@ class CS_CraftLogic
                 mag.ServerSetAmmoCount(quantity);
             }
 
-            Print("[CraftSystem] Item crafted: " + classname + " x" + quantity.ToString());
+#ifdef DEVELOPER
+            if (ModLogger.IsEnabled("CraftSystem", ModLogLevel.DEBUG))
+            {
+                ModLogger.Debug("CraftSystem", "Item crafted: " + classname + " x" + quantity.ToString());
+            }
+#endif
         }
         else
         {
-            Print("[CraftSystem] ERROR: Could not create item: " + classname);
+            ModLogger.Error("CraftSystem", "Could not create item: " + classname);
         }
     }
 }
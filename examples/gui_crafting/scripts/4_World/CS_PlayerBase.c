@@ -19,7 +19,7 @@ modded class PlayerBase
             if (g_CS_Handler)
             {
                 g_CS_Handler.ApplySettings(params.param1);
-                Print("[CraftSystem] Recipes received from server - " + params.param1.Recipes.Count() + " recipes");
+                ModLogger.Info("CraftSystem", "Recipes received from server - " + params.param1.Recipes.Count() + " recipes");
             }
         }
 
@@ -82,7 +82,7 @@ modded class PlayerBase
 
         if (recipeIndex < 0 || recipeIndex >= settings.Recipes.Count())
         {
-            Print("[CraftSystem] ERROR: Invalid recipe index: " + recipeIndex.ToString());
+            ModLogger.Error("CraftSystem", "Invalid recipe index: " + recipeIndex.ToString());
             return;
         }
 
@@ -90,7 +90,7 @@ modded class PlayerBase
 
         if (!recipe)
         {
-            Print("[CraftSystem] ERROR: Null recipe at index: " + recipeIndex.ToString());
+            ModLogger.Error("CraftSystem", "Null recipe at index: " + recipeIndex.ToString());
             return;
         }
 
@@ -108,7 +108,12 @@ modded class PlayerBase
             GetGame().RPCSingleParam(player, CS_Constants.RPC_CRAFT_RESULT, new Param2<bool, string>(success, recipe.DisplayName), true, player.GetIdentity());
         }
 
-        Print("[CraftSystem] Craft processed - Recipe: " + recipe.DisplayName + " - Success: " + success.ToString());
+#ifdef DEVELOPER
+        if (ModLogger.IsEnabled("CraftSystem", ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug("CraftSystem", "Craft processed - Recipe: " + recipe.DisplayName + " - Success: " + success.ToString());
+        }
+#endif
     }
 
     // Client requests crafting from server
@@ -119,6 +124,11 @@ modded class PlayerBase
         // Send RPC to server
         GetGame().RPCSingleParam(this, CS_Constants.RPC_REQUEST_CRAFT, new Param1<int>(recipeIndex), true);
 
-        Print("[CraftSystem] Requesting craft for recipe index: " + recipeIndex.ToString());
+#ifdef DEVELOPER
+        if (ModLogger.IsEnabled("CraftSystem", ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug("CraftSystem", "Requesting craft for recipe index: " + recipeIndex.ToString());
+        }
+#endif
     }
 }
@@ -0,0 +1,33 @@
+// config.cpp
+// Mod logger configuration
+
+class CfgPatches
+{
+    class ModLogger
+    {
+        units[]={};
+        weapons[]={};
+        requiredVersion=0.1;
+        requiredAddons[]={"DZ_Data", "DZ_Scripts"};
+    };
+};
+
+class CfgMods
+{
+    class ModLogger
+    {
+        type="mod";
+        author="DayZ Training";
+        dir="ModLogger";
+        name="Mod Logger";
+        dependencies[]={"Game"};
+        class defs
+        {
+            class gameScriptModule
+            {
+                value="";
+                files[]={"ModLogger/Scripts/3_Game"};
+            };
+        };
+    };
+};
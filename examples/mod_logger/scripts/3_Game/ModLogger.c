@@ -0,0 +1,289 @@
+// ============================================================
+// MOD LOGGER - Leveled, buffered logging shared by example mods
+// ============================================================
+// Usage pattern (the level check comes BEFORE building the string):
+//
+//     if (ModLogger.IsEnabled("ATM System", ModLogLevel.INFO))
+//     {
+//         ModLogger.Info("ATM System", "Deposit: " + name + " ...");
+//     }
+//
+// Debug messages are also wrapped in #ifdef DEVELOPER at the call
+// site, so release builds contain neither the check nor the string
+// concatenation:
+//
+//     #ifdef DEVELOPER
+//     if (ModLogger.IsEnabled("ATM System", ModLogLevel.DEBUG))
+//     {
+//         ModLogger.Debug("ATM System", "Account saved: " + id);
+//     }
+//     #endif
+//
+// Lines are buffered and appended to $profile:ModLogger/mods.log
+// once per FlushIntervalMs (errors flush immediately).
+
+enum ModLogLevel
+{
+    DEBUG,
+    INFO,
+    WARNING,
+    ERROR,
+    NONE        // Module silenced
+}
+
+// ============================================================
+// SETTINGS - $profile:ModLogger/logger.json
+// ============================================================
+class ModLoggerModuleLevel
+{
+    string Module;          // e.g. "ATM System", "FactionManager"
+    string Level;           // "debug", "info", "warning", "error", "none"
+}
+
+class ModLoggerSettings
+{
+    int FlushIntervalMs;
+    int MaxBufferedLines;           // Flush early when this many lines wait
+    bool EchoToScriptLog;           // Also Print() flushed lines
+    string DefaultLevel;
+    ref array<ref ModLoggerModuleLevel> Modules;
+
+    void ModLoggerSettings()
+    {
+        FlushIntervalMs = 1000;
+        MaxBufferedLines = 256;
+        EchoToScriptLog = true;
+        DefaultLevel = "info";
+        Modules = new array<ref ModLoggerModuleLevel>;
+    }
+}
+
+class ModLogger
+{
+    static const string LOG_DIR = "$profile:ModLogger/";
+    static const string SETTINGS_FILE = "$profile:ModLogger/logger.json";
+    static const string LOG_FILE = "$profile:ModLogger/mods.log";
+
+    protected ref ModLoggerSettings m_Settings;
+    protected ref map<string, int> m_Levels;        // Module -> ModLogLevel
+    protected ref map<string, bool> m_Configured;   // Modules set in logger.json
+    protected int m_DefaultLevel;
+
+    protected ref array<string> m_Buffer;
+    protected bool m_FlushScheduled;
+
+    private static ref ModLogger m_Instance;
+
+    // ============================================================
+    // GET INSTANCE - Singleton pattern
+    // ============================================================
+    static ModLogger GetInstance()
+    {
+        if (!m_Instance)
+        {
+            m_Instance = new ModLogger();
+        }
+
+        return m_Instance;
+    }
+
+    void ModLogger()
+    {
+        m_Levels = new map<string, int>;
+        m_Configured = new map<string, bool>;
+        m_Buffer = new array<string>;
+        m_FlushScheduled = false;
+
+        LoadSettings();
+    }
+
+    void ~ModLogger()
+    {
+        Flush();
+    }
+
+    // ============================================================
+    // STATIC API - Check level first, then format and log
+    // ============================================================
+    static bool IsEnabled(string module, int level)
+    {
+        return level >= GetInstance().GetLevel(module);
+    }
+
+    static void Debug(string module, string message)
+    {
+        GetInstance().Write(module, ModLogLevel.DEBUG, message);
+    }
+
+    static void Info(string module, string message)
+    {
+        GetInstance().Write(module, ModLogLevel.INFO, message);
+    }
+
+    static void Warning(string module, string message)
+    {
+        GetInstance().Write(module, ModLogLevel.WARNING, message);
+    }
+
+    static void Error(string module, string message)
+    {
+        GetInstance().Write(module, ModLogLevel.ERROR, message);
+    }
+
+    // ============================================================
+    // LEVELS
+    // ============================================================
+    int GetLevel(string module)
+    {
+        int level;
+        if (m_Levels.Find(module, level))
+        {
+            return level;
+        }
+
+        return m_DefaultLevel;
+    }
+
+    void SetLevel(string module, int level)
+    {
+        m_Levels.Set(module, level);
+    }
+
+    // Level from a mod's own config (e.g. BankingLogs); logger.json wins
+    void SetModuleDefault(string module, int level)
+    {
+        if (!m_Configured.Contains(module))
+        {
+            m_Levels.Set(module, level);
+        }
+    }
+
+    // ============================================================
+    // WRITE - Buffer one line
+    // ============================================================
+    void Write(string module, int level, string message)
+    {
+        if (level < GetLevel(module))
+        {
+            return;
+        }
+
+        m_Buffer.Insert(GetLevelName(level) + " [" + module + "] " + message);
+
+        if (level >= ModLogLevel.ERROR || m_Buffer.Count() >= m_Settings.MaxBufferedLines)
+        {
+            Flush();
+            return;
+        }
+
+        if (!m_FlushScheduled && GetGame())
+        {
+            m_FlushScheduled = true;
+            GetGame().GetCallQueue(CALL_CATEGORY_SYSTEM).CallLater(Flush, m_Settings.FlushIntervalMs, false);
+        }
+    }
+
+    // ============================================================
+    // FLUSH - Append buffered lines in one file open
+    // ============================================================
+    void Flush()
+    {
+        m_FlushScheduled = false;
+
+        if (m_Buffer.Count() == 0)
+        {
+            return;
+        }
+
+        int year, month, day, hour, minute, second;
+        GetYearMonthDay(year, month, day);
+        GetHourMinuteSecond(hour, minute, second);
+        string stamp = year.ToString() + "-" + month.ToStringLen(2) + "-" + day.ToStringLen(2) + " " + hour.ToStringLen(2) + ":" + minute.ToStringLen(2) + ":" + second.ToStringLen(2) + " ";
+
+        FileHandle file = OpenFile(LOG_FILE, FileMode.APPEND);
+
+        foreach (string line : m_Buffer)
+        {
+            if (file)
+            {
+                FPrintln(file, stamp + line);
+            }
+
+            if (m_Settings.EchoToScriptLog)
+            {
+                Print(line);
+            }
+        }
+
+        if (file)
+        {
+            CloseFile(file);
+        }
+
+        m_Buffer.Clear();
+    }
+
+    // ============================================================
+    // SETTINGS
+    // ============================================================
+    protected void LoadSettings()
+    {
+        m_Settings = new ModLoggerSettings();
+
+        if (!FileExist(LOG_DIR))
+        {
+            MakeDirectory(LOG_DIR);
+        }
+
+        if (FileExist(SETTINGS_FILE))
+        {
+            JsonFileLoader<ModLoggerSettings>.JsonLoadFile(SETTINGS_FILE, m_Settings);
+        }
+        else
+        {
+            JsonFileLoader<ModLoggerSettings>.JsonSaveFile(SETTINGS_FILE, m_Settings);
+        }
+
+        m_Settings.FlushIntervalMs = Math.Max(m_Settings.FlushIntervalMs, 50);
+        m_Settings.MaxBufferedLines = Math.Max(m_Settings.MaxBufferedLines, 1);
+        m_DefaultLevel = ParseLevel(m_Settings.DefaultLevel, ModLogLevel.INFO);
+
+        if (m_Settings.Modules)
+        {
+            foreach (ModLoggerModuleLevel entry : m_Settings.Modules)
+            {
+                m_Levels.Set(entry.Module, ParseLevel(entry.Level, m_DefaultLevel));
+                m_Configured.Set(entry.Module, true);
+            }
+        }
+    }
+
+    static int ParseLevel(string name, int fallback)
+    {
+        name.ToLower();
+
+        switch (name)
+        {
+            case "debug": return ModLogLevel.DEBUG;
+            case "info": return ModLogLevel.INFO;
+            case "warning": return ModLogLevel.WARNING;
+            case "error": return ModLogLevel.ERROR;
+            case "none": return ModLogLevel.NONE;
+        }
+
+        return fallback;
+    }
+
+    static string GetLevelName(int level)
+    {
+        switch (level)
+        {
+            case ModLogLevel.DEBUG: return "DEBUG";
+            case ModLogLevel.INFO: return "INFO ";
+            case ModLogLevel.WARNING: return "WARN ";
+            case ModLogLevel.ERROR: return "ERROR";
+        }
+
+        return "";
+    }
+}
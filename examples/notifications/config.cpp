@@ -8,7 +8,7 @@ class CfgPatches
         units[]={};
         weapons[]={};
         requiredVersion=0.1;
-        requiredAddons[]={"DZ_Data", "DZ_Scripts"};
+        requiredAddons[]={"DZ_Data", "DZ_Scripts", "PlayerRegistry", "ModLogger"};
     };
 };
 
@@ -11,25 +11,26 @@ class NotificationSystem
         Param1<string> msg = new Param1<string>(message);
         GetGame().RPCSingleParam(player, ERPCs.RPC_USER_ACTION_MESSAGE, msg, true, player.GetIdentity());
 
-        Print("[Notification] To " + player.GetIdentity().GetName() + ": " + message);
+#ifdef DEVELOPER
+        if (ModLogger.IsEnabled("Notification", ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug("Notification", "To " + player.GetIdentity().GetName() + ": " + message);
+        }
+#endif
     }
 
     // Broadcast to all players
     static void Broadcast(string message)
     {
-        array<Man> players = new array<Man>;
-        GetGame().GetPlayers(players);
-
-        foreach (Man man : players)
+        foreach (PlayerBase player : PlayerRegistry.GetInstance().GetPlayers())
         {
-            PlayerBase player = PlayerBase.Cast(man);
-            if (player)
-            {
-                Notify(player, message);
-            }
+            Notify(player, message);
         }
 
-        Print("[Notification] Broadcast: " + message);
+        if (ModLogger.IsEnabled("Notification", ModLogLevel.INFO))
+        {
+            ModLogger.Info("Notification", "Broadcast: " + message);
+        }
     }
 
     // Achievement notification
@@ -0,0 +1,33 @@
+// config.cpp
+// Player registry configuration
+
+class CfgPatches
+{
+    class PlayerRegistry
+    {
+        units[]={};
+        weapons[]={};
+        requiredVersion=0.1;
+        requiredAddons[]={"DZ_Data", "DZ_Scripts"};
+    };
+};
+
+class CfgMods
+{
+    class PlayerRegistry
+    {
+        type="mod";
+        author="DayZ Training";
+        dir="PlayerRegistry";
+        name="Player Registry";
+        dependencies[]={"Game", "World"};
+        class defs
+        {
+            class worldScriptModule
+            {
+                value="";
+                files[]={"PlayerRegistry/Scripts/4_World"};
+            };
+        };
+    };
+};
@@ -0,0 +1,54 @@
+modded class PlayerBase
+{
+    protected string m_RegistryPlainId;
+
+    override void OnConnect()
+    {
+        super.OnConnect();
+
+        if (GetGame().IsServer())
+        {
+            m_RegistryPlainId = PlayerRegistry.GetInstance().Register(this);
+        }
+    }
+
+    override void OnDisconnect()
+    {
+        super.OnDisconnect();
+
+        if (GetGame().IsServer())
+        {
+            UnregisterFromRegistry();
+        }
+    }
+
+    // Safety net: body deleted without OnDisconnect (e.g. kicked before ready)
+    override void EEDelete(EntityAI parent)
+    {
+        super.EEDelete(parent);
+
+        if (GetGame().IsServer())
+        {
+            UnregisterFromRegistry();
+        }
+    }
+
+    protected void UnregisterFromRegistry()
+    {
+        if (m_RegistryPlainId == "")
+            return;
+
+        // Only remove the entry if it still points to this character
+        if (PlayerRegistry.GetInstance().GetByPlainId(m_RegistryPlainId) == this)
+        {
+            PlayerRegistry.GetInstance().Unregister(m_RegistryPlainId);
+        }
+
+        m_RegistryPlainId = "";
+    }
+
+    string GetRegistryPlainId()
+    {
+        return m_RegistryPlainId;
+    }
+}
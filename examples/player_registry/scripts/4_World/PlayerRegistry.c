@@ -0,0 +1,132 @@
+// PlayerRegistry.c
+// Server-side registry of online players, shared by all example mods
+//
+// Maintained from PlayerBase.OnConnect / OnDisconnect, so callers never
+// need GetGame().GetPlayers() + a linear scan:
+// - GetByPlainId / GetByIdentityId: O(1) map lookup
+// - GetPlayers: stable list, no allocation per call (do not modify it)
+// - OnPlayerAdded / OnPlayerRemoved: change notifications
+
+class PlayerRegistry
+{
+    private static ref PlayerRegistry m_Instance;
+
+    protected ref array<PlayerBase> m_Players;
+    protected ref array<string> m_PlainIds;     // Parallel to m_Players
+    protected ref map<string, PlayerBase> m_ByPlainId;
+    protected ref map<string, PlayerBase> m_ByIdentityId;
+    protected ref map<string, string> m_IdentityIdByPlainId;
+    protected ref map<string, int> m_IndexByPlainId;
+
+    // Called with (PlayerBase player)
+    ref ScriptInvoker OnPlayerAdded = new ScriptInvoker();
+    ref ScriptInvoker OnPlayerRemoved = new ScriptInvoker();
+
+    static PlayerRegistry GetInstance()
+    {
+        if (!m_Instance)
+        {
+            m_Instance = new PlayerRegistry();
+        }
+
+        return m_Instance;
+    }
+
+    void PlayerRegistry()
+    {
+        m_Players = new array<PlayerBase>;
+        m_PlainIds = new array<string>;
+        m_ByPlainId = new map<string, PlayerBase>;
+        m_ByIdentityId = new map<string, PlayerBase>;
+        m_IdentityIdByPlainId = new map<string, string>;
+        m_IndexByPlainId = new map<string, int>;
+    }
+
+    // Add (or replace, e.g. after respawn) the player for this identity
+    // Returns the plain ID used as key, "" if the player has no identity
+    string Register(PlayerBase player)
+    {
+        if (!player || !player.GetIdentity())
+            return "";
+
+        string plainId = player.GetIdentity().GetPlainId();
+        string identityId = player.GetIdentity().GetId();
+
+        if (m_IndexByPlainId.Contains(plainId))
+        {
+            // Same identity, new character - swap in place
+            int index = m_IndexByPlainId.Get(plainId);
+            m_Players[index] = player;
+        }
+        else
+        {
+            m_IndexByPlainId.Set(plainId, m_Players.Count());
+            m_Players.Insert(player);
+            m_PlainIds.Insert(plainId);
+        }
+
+        m_ByPlainId.Set(plainId, player);
+        m_ByIdentityId.Set(identityId, player);
+        m_IdentityIdByPlainId.Set(plainId, identityId);
+
+        OnPlayerAdded.Invoke(player);
+        return plainId;
+    }
+
+    // Remove by plain ID (identity may already be gone on disconnect)
+    void Unregister(string plainId)
+    {
+        if (!m_IndexByPlainId.Contains(plainId))
+            return;
+
+        PlayerBase player = m_ByPlainId.Get(plainId);
+
+        // Swap-remove: move last player into the freed slot
+        int index = m_IndexByPlainId.Get(plainId);
+        int last = m_Players.Count() - 1;
+
+        if (index != last)
+        {
+            m_Players[index] = m_Players[last];
+            m_PlainIds[index] = m_PlainIds[last];
+            m_IndexByPlainId.Set(m_PlainIds[index], index);
+        }
+
+        m_Players.Remove(last);
+        m_PlainIds.Remove(last);
+        m_IndexByPlainId.Remove(plainId);
+        m_ByPlainId.Remove(plainId);
+        m_ByIdentityId.Remove(m_IdentityIdByPlainId.Get(plainId));
+        m_IdentityIdByPlainId.Remove(plainId);
+
+        OnPlayerRemoved.Invoke(player);
+    }
+
+    // Steam64 ID (PlayerIdentity.GetPlainId)
+    PlayerBase GetByPlainId(string plainId)
+    {
+        return m_ByPlainId.Get(plainId);
+    }
+
+    // Hashed identity ID (PlayerIdentity.GetId)
+    PlayerBase GetByIdentityId(string identityId)
+    {
+        return m_ByIdentityId.Get(identityId);
+    }
+
+    bool IsOnline(string plainId)
+    {
+        return m_ByPlainId.Contains(plainId);
+    }
+
+    // Shared list - iterate, do not modify
+    array<PlayerBase> GetPlayers()
+    {
+        return m_Players;
+    }
+
+    int Count()
+    {
+        return m_Players.Count();
+    }
+}
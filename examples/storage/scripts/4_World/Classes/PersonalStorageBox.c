@@ -56,7 +56,12 @@ class PersonalStorageBox extends Container_Base
 
         string steam64 = player.GetIdentity().GetId();
 
-        Print("Loading storage for " + steam64);
+#ifdef DEVELOPER
+        if (ModLogger.IsEnabled("Storage", ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug("Storage", "Loading storage for " + steam64);
+        }
+#endif
 
         // Создаем менеджер хранилища
         m_StorageManager = new StorageManager(steam64);
@@ -80,7 +85,12 @@ class PersonalStorageBox extends Container_Base
 
         string steam64 = player.GetIdentity().GetId();
 
-        Print("Saving storage for " + steam64);
+#ifdef DEVELOPER
+        if (ModLogger.IsEnabled("Storage", ModLogLevel.DEBUG))
+        {
+            ModLogger.Debug("Storage", "Saving storage for " + steam64);
+        }
+#endif
 
         // Создаем менеджер если не существует
         if (!m_StorageManager)
@@ -94,14 +104,11 @@ class PersonalStorageBox extends Container_Base
 
     PlayerBase GetOpenerPlayer()
     {
-        // Ищем ближайшего игрока
-        array<PlayerBase> players = new array<PlayerBase>;
-        GetGame().GetPlayers(players);
-
+        // Ищем ближайшего игрока (реестр онлайн-игроков, без GetPlayers)
         PlayerBase nearest = null;
         float minDistance = 3.0; // 3 метра
 
-        foreach (PlayerBase player : players)
+        foreach (PlayerBase player : PlayerRegistry.GetInstance().GetPlayers())
         {
             float distance = vector.Distance(GetPosition(), player.GetPosition());
 
@@ -14,7 +14,10 @@ class StorageManager
     {
         string filePath = "$profile:storage_" + m_Steam64_ID + ".json";
         JsonFileLoader<array<ref StoredItem>>::JsonSaveFile(filePath, m_StoredItems);
-        Print("Saved storage for " + m_Steam64_ID + " (" + m_StoredItems.Count() + " items)");
+        if (ModLogger.IsEnabled("Storage", ModLogLevel.INFO))
+        {
+            ModLogger.Info("Storage", "Saved storage for " + m_Steam64_ID + " (" + m_StoredItems.Count() + " items)");
+        }
     }
 
     void Load()
@@ -24,11 +27,19 @@ class StorageManager
         if (FileExist(filePath))
         {
             JsonFileLoader<array<ref StoredItem>>::JsonLoadFile(filePath, m_StoredItems);
-            Print("Loaded storage for " + m_Steam64_ID + " (" + m_StoredItems.Count() + " items)");
+            if (ModLogger.IsEnabled("Storage", ModLogLevel.INFO))
+            {
+                ModLogger.Info("Storage", "Loaded storage for " + m_Steam64_ID + " (" + m_StoredItems.Count() + " items)");
+            }
         }
         else
         {
-            Print("No storage file found for " + m_Steam64_ID);
+#ifdef DEVELOPER
+            if (ModLogger.IsEnabled("Storage", ModLogLevel.DEBUG))
+            {
+                ModLogger.Debug("Storage", "No storage file found for " + m_Steam64_ID);
+            }
+#endif
         }
     }
 
@@ -87,7 +98,7 @@ class StorageManager
 
         if (!item)
         {
-            Print("Failed to create item: " + stored.ClassName);
+            ModLogger.Warning("Storage", "Failed to create item: " + stored.ClassName);
             return null;
         }
 
@@ -175,7 +186,7 @@ class StorageManager
             {
                 if (!cargo.AddEntityToCargo(item))
                 {
-                    Print("Failed to add item to cargo: " + stored.ClassName);
+                    ModLogger.Warning("Storage", "Failed to add item to cargo: " + stored.ClassName);
                     GetGame().ObjectDelete(item);
                 }
             }
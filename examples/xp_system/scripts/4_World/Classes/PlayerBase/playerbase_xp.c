@@ -1,74 +1,86 @@
-modded class PlayerBase
+// События убийства, крафта и чтения приходят из GameEventBus
+class XPEventListener : GameEventListener
 {
-    protected SkillManager m_SkillManager;
+    protected static bool s_Registered;
 
-    override void OnConnect()
+    static void Register()
     {
-        super.OnConnect();
+        if (s_Registered)
+            return;
 
-        // Создаем менеджер навыков
-        m_SkillManager = new SkillManager(this);
-        m_SkillManager.LoadSkills();
+        s_Registered = true;
 
-        Print("Player " + GetIdentity().GetName() + " connected. XP system initialized.");
+        GameEventBus bus = GameEventBus.GetInstance();
+        XPEventListener listener = new XPEventListener();
+        bus.Subscribe(GameEventType.KILL, listener, "XPSystem");
+        bus.Subscribe(GameEventType.CRAFT, listener, "XPSystem");
+        bus.Subscribe(GameEventType.READ, listener, "XPSystem");
     }
 
-    override void OnDisconnect()
+    // XP за убийство зомби (как и прежний EEKilled в PlayerBase: жертва - игрок)
+    override void OnKill(GameKillEvent e)
     {
-        super.OnDisconnect();
+        if (!e.VictimIsPlayer)
+            return;
 
-        if (m_SkillManager)
+        PlayerBase player = PlayerBase.Cast(e.Killer);
+        if (player && player.GetSkillManager())
         {
-            m_SkillManager.SaveSkills();
-            Print("Player " + GetIdentity().GetName() + " disconnected. Skills saved.");
+            player.GetSkillManager().OnZombieKilled();
         }
     }
 
-    // XP за убийство зомби
-    override void EEKilled(Object killer)
+    // XP за крафтинг
+    override void OnCraft(GameCraftEvent e)
     {
-        super.EEKilled(killer);
-
-        // Даем XP убийце
-        if (killer && killer.IsMan())
+        PlayerBase player = PlayerBase.Cast(e.Player);
+        if (player && player.GetSkillManager())
         {
-            Man man = killer.CastToMan();
-            if (man && man.IsPlayer())
-            {
-                PlayerBase player = PlayerBase.Cast(man);
-                if (player && player.m_SkillManager)
-                {
-                    player.m_SkillManager.OnZombieKilled();
-                }
-            }
+            player.GetSkillManager().OnItemCrafted();
         }
     }
 
-    // Доступ к менеджеру навыков
-    SkillManager GetSkillManager()
+    // XP за чтение книги
+    override void OnRead(GameReadEvent e)
     {
-        return m_SkillManager;
+        PlayerBase player = PlayerBase.Cast(e.Player);
+        if (player && player.GetSkillManager())
+        {
+            player.GetSkillManager().OnBookRead();
+        }
     }
+}
 
-    // XP за чтение книги
-    override void ReadItem(ItemBase book)
+modded class PlayerBase
+{
+    protected SkillManager m_SkillManager;
+
+    override void OnConnect()
     {
-        super.ReadItem(book);
+        super.OnConnect();
 
-        if (m_SkillManager)
-        {
-            m_SkillManager.OnBookRead();
-        }
+        // Создаем менеджер навыков
+        m_SkillManager = new SkillManager(this);
+        m_SkillManager.LoadSkills();
+        XPEventListener.Register();
+
+        Print("Player " + GetIdentity().GetName() + " connected. XP system initialized.");
     }
 
-    // XP за крафтинг
-    override void CraftItem(ItemBase item)
+    override void OnDisconnect()
     {
-        super.CraftItem(item);
+        super.OnDisconnect();
 
         if (m_SkillManager)
         {
-            m_SkillManager.OnItemCrafted();
+            m_SkillManager.SaveSkills();
+            Print("Player " + GetIdentity().GetName() + " disconnected. Skills saved.");
         }
     }
+
+    // Доступ к менеджеру навыков
+    SkillManager GetSkillManager()
+    {
+        return m_SkillManager;
+    }
 }
@@ -34,16 +34,9 @@ class SimpleSkill
         Print("Skill " + Name + " leveled up to " + Level);
 
         // Уведомляем всех игроков (опционально)
-        array<Man> players = new array<Man>;
-        GetGame().GetPlayers(players);
-
-        foreach (Man player : players)
+        foreach (PlayerBase pb : PlayerRegistry.GetInstance().GetPlayers())
         {
-            PlayerBase pb = PlayerBase.Cast(player);
-            if (pb)
-            {
-                NotificationSystem.Notify(pb, Name + " leveled up to " + Level + "!");
-            }
+            NotificationSystem.Notify(pb, Name + " leveled up to " + Level + "!");
         }
     }
 